@@ -0,0 +1,170 @@
+#ifndef FT_CONTAINERS_BENCH_HPP
+#define FT_CONTAINERS_BENCH_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include <unistd.h>
+#include <cstring>
+
+namespace bench {
+
+	class timer {
+
+	private:
+		struct timeval _start;
+
+	public:
+		timer() { reset(); }
+
+		void reset() { gettimeofday(&_start, NULL); }
+
+		double elapsed_ms() const {
+			struct timeval now;
+			gettimeofday(&now, NULL);
+			return (now.tv_sec - _start.tv_sec) * 1000.0 + (now.tv_usec - _start.tv_usec) / 1000.0;
+		}
+	};
+
+	struct alloc_stats {
+		std::size_t allocations;
+		std::size_t deallocations;
+		std::size_t bytes_allocated;
+		std::size_t bytes_deallocated;
+		std::size_t bytes_live;
+		std::size_t peak_bytes;
+
+		// Clears the counters; bytes_live keeps tracking what is still held, so peak_bytes
+		// restarts from the current footprint.
+		void reset() {
+			allocations = deallocations = bytes_allocated = bytes_deallocated = 0;
+			peak_bytes = bytes_live;
+		}
+
+		static alloc_stats &instance() {
+			static alloc_stats stats = alloc_stats();
+			return stats;
+		}
+	};
+
+	/*
+	 * std::allocator wrapper that records every allocate/deallocate call in alloc_stats.
+	 */
+	template<class T>
+	class counting_allocator : public std::allocator<T> {
+
+	public:
+		typedef std::allocator<T> base_type;
+		typedef typename base_type::pointer pointer;
+		typedef typename base_type::size_type size_type;
+
+		template<class U>
+		struct rebind {
+			typedef counting_allocator<U> other;
+		};
+
+		counting_allocator() {}
+
+		counting_allocator(const counting_allocator &other) : base_type(other) {}
+
+		template<class U>
+		counting_allocator(const counting_allocator<U> &other) : base_type(other) {}
+
+		pointer allocate(size_type n, const void * = 0) {
+			alloc_stats::instance().allocations++;
+			alloc_stats::instance().bytes_allocated += n * sizeof(T);
+			alloc_stats::instance().bytes_live += n * sizeof(T);
+			if (alloc_stats::instance().bytes_live > alloc_stats::instance().peak_bytes)
+				alloc_stats::instance().peak_bytes = alloc_stats::instance().bytes_live;
+			return base_type::allocate(n);
+		}
+
+		void deallocate(pointer p, size_type n) {
+			alloc_stats::instance().deallocations++;
+			alloc_stats::instance().bytes_deallocated += n * sizeof(T);
+			alloc_stats::instance().bytes_live -= n * sizeof(T);
+			base_type::deallocate(p, n);
+		}
+	};
+
+	/*
+	 * A hardware counter of this process read through perf_event_open. When the kernel
+	 * or the sandbox refuses it, available() is false and read() returns -1.
+	 */
+	class perf_counter {
+
+	private:
+		int _fd;
+
+	public:
+		enum event { DTLB_MISSES, CACHE_MISSES };
+
+		explicit perf_counter(event e) {
+			struct perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			if (e == DTLB_MISSES) {
+				attr.type = PERF_TYPE_HW_CACHE;
+				attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+							  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+			} else {
+				attr.type = PERF_TYPE_HARDWARE;
+				attr.config = PERF_COUNT_HW_CACHE_MISSES;
+			}
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			_fd = (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+		}
+
+		~perf_counter() {
+			if (_fd >= 0) close(_fd);
+		}
+
+		bool available() const { return _fd >= 0; }
+
+		void start() {
+			if (_fd < 0) return;
+			ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+			ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+		}
+
+		long long stop() {
+			if (_fd < 0) return -1;
+			ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+			long long value = 0;
+			if (read(_fd, &value, sizeof(value)) != sizeof(value))
+				return -1;
+			return value;
+		}
+
+	private:
+		perf_counter(const perf_counter &);
+
+		perf_counter &operator=(const perf_counter &);
+	};
+
+	// Minor and major page faults taken by the process so far.
+	inline long page_faults() {
+		struct rusage usage;
+		getrusage(RUSAGE_SELF, &usage);
+		return usage.ru_minflt + usage.ru_majflt;
+	}
+
+	template<class T>
+	inline void do_not_optimize(const T &value) {
+		asm volatile("" : : "r"(&value) : "memory");
+	}
+
+	inline void print_row(const char *name, double ms, const char *extra = "") {
+		std::printf("  %-40s %10.2f ms  %s\n", name, ms, extra);
+	}
+
+}
+
+#endif
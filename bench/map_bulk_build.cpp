@@ -0,0 +1,75 @@
+#include <bench.hpp>
+#include <map.hpp>
+#include <vector.hpp>
+#include <map>
+#include <vector>
+#include <cstdlib>
+
+/*
+ * Builds a map from SIZE sorted, unique keys: one insert at a time, through the
+ * range constructor (which notices the input is sorted), and with the
+ * from_sorted_unique tag that skips the check. std::map's range constructor is
+ * shown for comparison. Every run starts from the same source vector.
+ */
+
+typedef ft::map<int, int> map_type;
+typedef ft::vector<ft::pair<int, int> > source_type;
+
+void one_by_one(const char *name, const source_type &src) {
+	bench::timer timer;
+	map_type *m = new map_type();
+	for (source_type::const_iterator it = src.begin(); it != src.end(); ++it)
+		m->insert(*it);
+	double ms = timer.elapsed_ms();
+	bench::do_not_optimize(m);
+	bench::print_row(name, ms);
+	delete m;
+}
+
+void range(const char *name, const source_type &src) {
+	bench::timer timer;
+	map_type *m = new map_type(src.begin(), src.end());
+	double ms = timer.elapsed_ms();
+	bench::do_not_optimize(m);
+	bench::print_row(name, ms);
+	delete m;
+}
+
+void tagged(const char *name, const source_type &src) {
+	bench::timer timer;
+	map_type *m = new map_type(ft::from_sorted_unique, src.begin(), src.end());
+	double ms = timer.elapsed_ms();
+	bench::do_not_optimize(m);
+	bench::print_row(name, ms);
+	delete m;
+}
+
+void std_range(const char *name, const std::vector<std::pair<int, int> > &src) {
+	bench::timer timer;
+	std::map<int, int> *m = new std::map<int, int>(src.begin(), src.end());
+	double ms = timer.elapsed_ms();
+	bench::do_not_optimize(m);
+	bench::print_row(name, ms);
+	delete m;
+}
+
+int main(int argc, char **argv) {
+	std::size_t size = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 10000000;
+
+	source_type src;
+	std::vector<std::pair<int, int> > std_src;
+	src.reserve(size);
+	std_src.reserve(size);
+	for (std::size_t i = 0; i < size; i++) {
+		src.push_back(ft::make_pair((int) i * 2, (int) i));
+		std_src.push_back(std::make_pair((int) i * 2, (int) i));
+	}
+
+	std::printf("%lu sorted keys\n", (unsigned long) size);
+	tagged("(warm-up)", src);
+	one_by_one("ft::map insert one by one", src);
+	range("ft::map range constructor", src);
+	tagged("ft::map from_sorted_unique", src);
+	std_range("std::map range constructor", std_src);
+	return 0;
+}
@@ -0,0 +1,48 @@
+#include <bench.hpp>
+#include <map.hpp>
+#include <map>
+#include <cstdlib>
+
+/*
+ * Keeps about SIZE keys in a map and runs OPS random inserts and erases against it,
+ * with a counting allocator passed as the map Allocator. ft::map takes its nodes
+ * from the pool, so the allocator only sees the chunks; std::map is shown for
+ * comparison with one allocation per node.
+ */
+
+template<class Map>
+void run(const char *name, std::size_t size, std::size_t ops) {
+	bench::alloc_stats &stats = bench::alloc_stats::instance();
+	std::srand(42);
+	Map *m = new Map();
+	for (std::size_t i = 0; i < size; i++)
+		m->insert(typename Map::value_type(std::rand() % (int) (size * 2), 0));
+
+	stats.reset();
+	bench::timer timer;
+	for (std::size_t i = 0; i < ops; i++) {
+		int key = std::rand() % (int) (size * 2);
+		if (i & 1)
+			m->erase(key);
+		else
+			m->insert(typename Map::value_type(key, 0));
+	}
+	double ms = timer.elapsed_ms();
+	bench::do_not_optimize(m);
+
+	char extra[128];
+	std::snprintf(extra, sizeof(extra), "allocations: %lu  deallocations: %lu",
+				  (unsigned long) stats.allocations, (unsigned long) stats.deallocations);
+	bench::print_row(name, ms, extra);
+	delete m;
+}
+
+int main(int argc, char **argv) {
+	std::size_t size = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 100000;
+	std::size_t ops = argc > 2 ? std::strtoul(argv[2], NULL, 10) : 2000000;
+
+	std::printf("%lu keys, %lu insert/erase operations\n", (unsigned long) size, (unsigned long) ops);
+	run<ft::map<int, int, ft::less<int>, bench::counting_allocator<ft::pair<const int, int> > > >("ft::map", size, ops);
+	run<std::map<int, int, std::less<int>, bench::counting_allocator<std::pair<const int, int> > > >("std::map", size, ops);
+	return 0;
+}
@@ -0,0 +1,61 @@
+#include <bench.hpp>
+#include <map.hpp>
+#include <vector.hpp>
+#include <cstdlib>
+
+/*
+ * Resolves QUERIES random keys, BATCH at a time, against a map of COUNT keys (about
+ * half of the queries hit). The default map is a few hundred MB, well past the last
+ * level cache, so every lookup is a chain of cache misses: a find() loop takes them
+ * one after the other, find_many() overlaps them.
+ */
+
+typedef ft::map<int, int> map_type;
+
+void run(const char *name, map_type &m, const ft::vector<int> &queries, std::size_t batch, bool many) {
+	ft::vector<map_type::iterator> out(batch);
+	long sum = 0;
+	bench::timer timer;
+	for (std::size_t q = 0; q + batch <= queries.size(); q += batch) {
+		if (many) {
+			m.find_many(queries.begin() + q, queries.begin() + q + batch, out.begin());
+		} else {
+			for (std::size_t i = 0; i < batch; i++)
+				out[i] = m.find(queries[q + i]);
+		}
+		for (std::size_t i = 0; i < batch; i++)
+			if (out[i] != m.end())
+				sum += out[i]->second;
+	}
+	double ms = timer.elapsed_ms();
+	bench::do_not_optimize(sum);
+
+	char extra[64];
+	std::snprintf(extra, sizeof(extra), "%.0f ns/lookup  checksum %ld", ms * 1e6 / (double) queries.size(), sum);
+	bench::print_row(name, ms, extra);
+}
+
+int main(int argc, char **argv) {
+	std::size_t count = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 4000000;
+	std::size_t nqueries = argc > 2 ? std::strtoul(argv[2], NULL, 10) : 2000000;
+	std::size_t batch = argc > 3 ? std::strtoul(argv[3], NULL, 10) : 128;
+
+	ft::vector<ft::pair<int, int> > values;
+	values.reserve(count);
+	for (std::size_t i = 0; i < count; i++)
+		values.push_back(ft::make_pair((int) i * 2, 1));
+	map_type m(ft::from_sorted_unique, values.begin(), values.end());
+
+	std::srand(42);
+	ft::vector<int> queries;
+	queries.reserve(nqueries);
+	for (std::size_t i = 0; i < nqueries; i++)
+		queries.push_back((int) (((unsigned long) std::rand() * RAND_MAX + std::rand()) % (count * 2)));
+
+	std::printf("%lu keys, %lu lookups in batches of %lu\n", (unsigned long) count, (unsigned long) nqueries,
+				(unsigned long) batch);
+	run("(warm-up)", m, queries, batch, false);
+	run("find() loop", m, queries, batch, false);
+	run("find_many()", m, queries, batch, true);
+	return 0;
+}
@@ -0,0 +1,70 @@
+#include <bench.hpp>
+#include <map.hpp>
+#include <map>
+#include <cstdlib>
+
+/*
+ * Inserts COUNT timestamps into an empty map, once strictly ascending and once
+ * near-sorted (every key lands within a few places of the end). Each map is filled
+ * without a hint, with end() as the hint, and with the iterator returned by the
+ * previous insert as the hint. The first run only warms up the heap.
+ */
+
+enum hint_kind { NO_HINT, END_HINT, LAST_HINT };
+
+template<class Map, class Value>
+void run(const char *name, hint_kind hint, const ft::vector<int> &keys) {
+	bench::timer timer;
+	Map m;
+	typename Map::iterator last = m.end();
+	for (std::size_t i = 0; i < keys.size(); i++) {
+		Value value(keys[i], 0);
+		if (hint == NO_HINT)
+			m.insert(value);
+		else if (hint == END_HINT)
+			m.insert(m.end(), value);
+		else
+			last = m.insert(last, value);
+	}
+	double ms = timer.elapsed_ms();
+	bench::do_not_optimize(m.size());
+
+	char extra[64];
+	std::snprintf(extra, sizeof(extra), "%.1f M inserts/s", keys.size() / ms / 1000.0);
+	bench::print_row(name, ms, extra);
+}
+
+typedef ft::map<int, int> ft_map;
+typedef ft::pair<const int, int> ft_value;
+typedef std::map<int, int> std_map;
+typedef std::pair<const int, int> std_value;
+
+void run_all(const ft::vector<int> &keys) {
+	run<ft_map, ft_value>("ft::map insert(value)", NO_HINT, keys);
+	run<ft_map, ft_value>("ft::map insert(end(), value)", END_HINT, keys);
+	run<ft_map, ft_value>("ft::map insert(last, value)", LAST_HINT, keys);
+	run<std_map, std_value>("std::map insert(value)", NO_HINT, keys);
+	run<std_map, std_value>("std::map insert(end(), value)", END_HINT, keys);
+	run<std_map, std_value>("std::map insert(last, value)", LAST_HINT, keys);
+}
+
+int main(int argc, char **argv) {
+	std::size_t count = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 2000000;
+
+	std::srand(42);
+	ft::vector<int> ascending;
+	ft::vector<int> near_sorted;
+	ascending.reserve(count);
+	near_sorted.reserve(count);
+	for (std::size_t i = 0; i < count; i++) {
+		ascending.push_back((int) i);
+		near_sorted.push_back((int) i * 4 + std::rand() % 8);
+	}
+
+	run<ft_map, ft_value>("(warm-up)", NO_HINT, ascending);
+	std::printf("%lu ascending keys\n", (unsigned long) count);
+	run_all(ascending);
+	std::printf("%lu near-sorted keys\n", (unsigned long) count);
+	run_all(near_sorted);
+	return 0;
+}
@@ -0,0 +1,67 @@
+#include <bench.hpp>
+#include <map.hpp>
+#include <map>
+#include <cstdlib>
+
+/*
+ * Inserts COUNT random keys drawn from [0, COUNT) into an empty tree, so roughly a
+ * third of them are already present. "find + insert" is the old two-descent path
+ * of map::insert, "insert_unique" the single descent it uses now. The first run
+ * only warms up the heap, so that every measured run allocates its nodes from the
+ * same recycled free lists.
+ */
+
+typedef ft::pair<const int, int> value_type;
+typedef ft::map<int, int>::tree_type tree_type;
+
+enum strategy { FIND_THEN_INSERT, INSERT_UNIQUE, FT_MAP, STD_MAP };
+
+void run(const char *name, strategy s, const ft::vector<int> &keys) {
+	std::size_t inserted = 0;
+	bench::timer timer;
+
+	if (s == FIND_THEN_INSERT || s == INSERT_UNIQUE) {
+		tree_type tree;
+		for (std::size_t i = 0; i < keys.size(); i++) {
+			value_type value(keys[i], 0);
+			if (s == INSERT_UNIQUE)
+				inserted += tree.insert_unique(value).second;
+			else if (tree.find(value.first) == tree.end()) {
+				tree.insert(value);
+				inserted++;
+			}
+		}
+		tree.clear();
+	} else if (s == FT_MAP) {
+		ft::map<int, int> m;
+		for (std::size_t i = 0; i < keys.size(); i++)
+			inserted += m.insert(value_type(keys[i], 0)).second;
+	} else {
+		std::map<int, int> m;
+		for (std::size_t i = 0; i < keys.size(); i++)
+			inserted += m.insert(std::make_pair(keys[i], 0)).second;
+	}
+	bench::do_not_optimize(inserted);
+
+	char extra[64];
+	std::snprintf(extra, sizeof(extra), "inserted: %lu", (unsigned long) inserted);
+	bench::print_row(name, timer.elapsed_ms(), extra);
+}
+
+int main(int argc, char **argv) {
+	std::size_t count = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 1000000;
+
+	std::srand(42);
+	ft::vector<int> keys;
+	keys.reserve(count);
+	for (std::size_t i = 0; i < count; i++)
+		keys.push_back(std::rand() % (int) count);
+
+	std::printf("%lu random keys\n", (unsigned long) count);
+	run("(warm-up)", INSERT_UNIQUE, keys);
+	run("RBTree find + insert", FIND_THEN_INSERT, keys);
+	run("RBTree insert_unique", INSERT_UNIQUE, keys);
+	run("ft::map insert", FT_MAP, keys);
+	run("std::map insert", STD_MAP, keys);
+	return 0;
+}
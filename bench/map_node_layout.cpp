@@ -0,0 +1,87 @@
+#include <bench.hpp>
+#include <map.hpp>
+#include <set.hpp>
+#include <cstdlib>
+
+/*
+ * Compares the default node layout with rbtree_options<true>, which packs the
+ * color into the parent pointer. Reports node size and allocator bytes per
+ * element for small key types, then times LOOKUPS random finds in a COUNT-key
+ * map<int, int> with hardware cache misses when perf events are available.
+ */
+
+typedef bench::counting_allocator<ft::pair<const int, int> > pair_allocator;
+typedef ft::map<int, int, ft::less<int>, pair_allocator> map_type;
+typedef ft::map<int, int, ft::less<int>, pair_allocator, ft::rbtree_options<true> > compact_map_type;
+typedef ft::set<int, ft::less<int>, bench::counting_allocator<int> > set_type;
+typedef ft::set<int, ft::less<int>, bench::counting_allocator<int>, ft::rbtree_options<true> > compact_set_type;
+typedef ft::set<char, ft::less<char>, bench::counting_allocator<char> > char_set_type;
+typedef ft::set<char, ft::less<char>, bench::counting_allocator<char>, ft::rbtree_options<true> > compact_char_set_type;
+
+template<class K>
+K make_value(std::size_t i, K *) {
+	return static_cast<K>(i);
+}
+
+template<class K, class V>
+ft::pair<const K, V> make_value(std::size_t i, ft::pair<const K, V> *) {
+	return ft::pair<const K, V>(static_cast<K>(i), V());
+}
+
+template<class Container>
+void footprint(const char *name, std::size_t count) {
+	bench::alloc_stats &stats = bench::alloc_stats::instance();
+	stats.reset();
+	Container *c = new Container();
+	for (std::size_t i = 0; i < count; i++)
+		c->insert(make_value(i, (typename Container::value_type *) NULL));
+	double per_element = c->size() ? (double) stats.bytes_allocated / c->size() : 0;
+	char extra[96];
+	std::snprintf(extra, sizeof(extra), "node: %3lu bytes  allocated per element: %6.2f bytes",
+				  (unsigned long) sizeof(typename Container::node_type), per_element);
+	std::printf("  %-40s %s\n", name, extra);
+	delete c;
+}
+
+template<class Map>
+void lookups(const char *name, std::size_t count, std::size_t lookups) {
+	Map m;
+	for (std::size_t i = 0; i < count; i++)
+		m.insert(typename Map::value_type((int) (i * 2), (int) i));
+
+	std::srand(42);
+	bench::perf_counter misses(bench::perf_counter::CACHE_MISSES);
+	long found = 0;
+	bench::timer timer;
+	misses.start();
+	for (std::size_t i = 0; i < lookups; i++)
+		found += m.find(std::rand() % (int) (count * 2)) != m.end();
+	long long miss_count = misses.stop();
+	double ms = timer.elapsed_ms();
+	bench::do_not_optimize(found);
+
+	char extra[96];
+	if (miss_count >= 0)
+		std::snprintf(extra, sizeof(extra), "cache misses per lookup: %.2f", (double) miss_count / lookups);
+	else
+		std::snprintf(extra, sizeof(extra), "cache misses: n/a");
+	bench::print_row(name, ms, extra);
+}
+
+int main(int argc, char **argv) {
+	std::size_t count = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 2000000;
+	std::size_t lookups_count = argc > 2 ? std::strtoul(argv[2], NULL, 10) : 2000000;
+
+	std::printf("footprint, 100000 elements (set<char>: 128)\n");
+	footprint<char_set_type>("set<char>", 128);
+	footprint<compact_char_set_type>("set<char>, compact", 128);
+	footprint<set_type>("set<int>", 100000);
+	footprint<compact_set_type>("set<int>, compact", 100000);
+	footprint<map_type>("map<int, int>", 100000);
+	footprint<compact_map_type>("map<int, int>, compact", 100000);
+
+	std::printf("%lu random lookups in %lu keys\n", (unsigned long) lookups_count, (unsigned long) count);
+	lookups<map_type>("map<int, int>", count, lookups_count);
+	lookups<compact_map_type>("map<int, int>, compact", count, lookups_count);
+	return 0;
+}
@@ -0,0 +1,65 @@
+#include <bench.hpp>
+#include <map.hpp>
+#include <cstdlib>
+
+/*
+ * A latency histogram: COUNT random keys, then QUERIES rounds that read the p50,
+ * p90, p99 and p99.9 keys and the rank of a random key. The plain map walks with
+ * iterators; the order-statistics map uses nth() and rank(). Insert time shows
+ * what maintaining the subtree sizes costs.
+ */
+
+typedef ft::map<int, int> plain_map;
+typedef ft::map<int, int, ft::less<int>, std::allocator<ft::pair<const int, int> >,
+		ft::rbtree_options<false, true> > ranked_map;
+
+static const double percentiles[] = {0.5, 0.9, 0.99, 0.999};
+
+long query(plain_map &m, int key) {
+	long sum = 0;
+	for (std::size_t p = 0; p < sizeof(percentiles) / sizeof(*percentiles); p++) {
+		plain_map::iterator it = m.begin();
+		for (std::size_t i = (std::size_t) (percentiles[p] * m.size()); i > 0; i--)
+			++it;
+		sum += it->first;
+	}
+	plain_map::iterator bound = m.lower_bound(key);
+	return sum + ft::distance(m.begin(), bound);
+}
+
+long query(ranked_map &m, int key) {
+	long sum = 0;
+	for (std::size_t p = 0; p < sizeof(percentiles) / sizeof(*percentiles); p++)
+		sum += m.nth((std::size_t) (percentiles[p] * m.size()))->first;
+	return sum + (long) m.rank(key);
+}
+
+template<class Map>
+void run(const char *name, std::size_t count, std::size_t queries) {
+	std::srand(42);
+	Map m;
+	bench::timer timer;
+	for (std::size_t i = 0; i < count; i++)
+		m.insert(typename Map::value_type(std::rand(), 0));
+	double insert_ms = timer.elapsed_ms();
+
+	timer.reset();
+	long sum = 0;
+	for (std::size_t i = 0; i < queries; i++)
+		sum += query(m, std::rand());
+	bench::do_not_optimize(sum);
+
+	char extra[64];
+	std::snprintf(extra, sizeof(extra), "insert: %9.2f ms", insert_ms);
+	bench::print_row(name, timer.elapsed_ms(), extra);
+}
+
+int main(int argc, char **argv) {
+	std::size_t count = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 1000000;
+	std::size_t queries = argc > 2 ? std::strtoul(argv[2], NULL, 10) : 20;
+
+	std::printf("%lu keys, %lu percentile queries\n", (unsigned long) count, (unsigned long) queries);
+	run<plain_map>("iterator walk", count, queries);
+	run<ranked_map>("nth / rank", count, queries);
+	return 0;
+}
@@ -0,0 +1,58 @@
+#include <bench.hpp>
+#include <map.hpp>
+#include <map>
+#include <cstdlib>
+
+/*
+ * Runs QUERIES short range scans over a map of COUNT random keys: lower_bound on a
+ * random key, then up to STEPS increments. The threaded map follows its in-order
+ * links, the default one walks the tree; std::map is shown for comparison.
+ */
+
+typedef ft::map<int, int> plain_map;
+typedef ft::map<int, int, ft::less<int>, std::allocator<ft::pair<const int, int> >,
+		ft::rbtree_options<false, false, true> > threaded_map;
+
+template<class Map>
+void run(const char *name, const ft::vector<int> &keys, const ft::vector<int> &queries, std::size_t steps) {
+	Map m;
+	for (std::size_t i = 0; i < keys.size(); i++)
+		m.insert(typename Map::value_type(keys[i], 1));
+
+	long sum = 0;
+	bench::timer timer;
+	for (std::size_t q = 0; q < queries.size(); q++) {
+		typename Map::const_iterator it = m.lower_bound(queries[q]);
+		typename Map::const_iterator end = m.end();
+		for (std::size_t s = 0; s < steps && it != end; s++, ++it)
+			sum += it->second;
+	}
+	double ms = timer.elapsed_ms();
+	bench::do_not_optimize(sum);
+
+	char extra[64];
+	std::snprintf(extra, sizeof(extra), "%.0f ns/scan", ms * 1e6 / (double) queries.size());
+	bench::print_row(name, ms, extra);
+}
+
+int main(int argc, char **argv) {
+	std::size_t count = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 1000000;
+	std::size_t nqueries = argc > 2 ? std::strtoul(argv[2], NULL, 10) : 100000;
+	std::size_t steps = argc > 3 ? std::strtoul(argv[3], NULL, 10) : 100;
+
+	std::srand(42);
+	ft::vector<int> keys;
+	ft::vector<int> queries;
+	for (std::size_t i = 0; i < count; i++)
+		keys.push_back(std::rand());
+	for (std::size_t i = 0; i < nqueries; i++)
+		queries.push_back(std::rand());
+
+	std::printf("%lu keys, %lu scans of %lu steps\n", (unsigned long) count, (unsigned long) nqueries,
+				(unsigned long) steps);
+	run<plain_map>("(warm-up)", keys, queries, steps);
+	run<plain_map>("ft::map", keys, queries, steps);
+	run<threaded_map>("ft::map threaded", keys, queries, steps);
+	run<std::map<int, int> >("std::map", keys, queries, steps);
+	return 0;
+}
@@ -0,0 +1,58 @@
+#include <bench.hpp>
+#include <map.hpp>
+#include <map>
+#include <string>
+#include <cstdlib>
+
+/*
+ * Walks every element of a map with COUNT random keys, once with int keys and once
+ * with 16-character string keys, and reports the time per step. Iterators only
+ * follow parent/child links, so the key type should not matter beyond cache
+ * footprint; std::map is shown for comparison.
+ */
+
+template<class Map>
+void run(const char *name, const Map &m, std::size_t rounds) {
+	long sum = 0;
+	bench::timer timer;
+	for (std::size_t r = 0; r < rounds; r++)
+		for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+			sum += it->second;
+	double ms = timer.elapsed_ms();
+	bench::do_not_optimize(sum);
+
+	char extra[64];
+	std::snprintf(extra, sizeof(extra), "%.2f ns/step", ms * 1e6 / (double) (m.size() * rounds));
+	bench::print_row(name, ms, extra);
+}
+
+std::string make_key(int n) {
+	char buf[32];
+	std::snprintf(buf, sizeof(buf), "key-%012d", n);
+	return std::string(buf);
+}
+
+int main(int argc, char **argv) {
+	std::size_t count = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 100000;
+	std::size_t rounds = argc > 2 ? std::strtoul(argv[2], NULL, 10) : 50;
+
+	std::srand(42);
+	ft::map<int, int> ft_int;
+	std::map<int, int> std_int;
+	ft::map<std::string, int> ft_string;
+	std::map<std::string, int> std_string;
+	for (std::size_t i = 0; i < count; i++) {
+		int key = std::rand();
+		ft_int.insert(ft::make_pair(key, 1));
+		std_int.insert(std::make_pair(key, 1));
+		ft_string.insert(ft::make_pair(make_key(key), 1));
+		std_string.insert(std::make_pair(make_key(key), 1));
+	}
+
+	std::printf("%lu keys, %lu full scans\n", (unsigned long) count, (unsigned long) rounds);
+	run("ft::map<int, int>", ft_int, rounds);
+	run("std::map<int, int>", std_int, rounds);
+	run("ft::map<std::string, int>", ft_string, rounds);
+	run("std::map<std::string, int>", std_string, rounds);
+	return 0;
+}
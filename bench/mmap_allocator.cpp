@@ -0,0 +1,61 @@
+#include <bench.hpp>
+#include <vector.hpp>
+#include <mmap_allocator.hpp>
+#include <cstdlib>
+
+/*
+ * Grows a vector of 4 KB Buffers to MEGABYTES with push_back, then reads random
+ * elements. Reports growth time, reallocations and data TLB misses of the random
+ * pass for std::allocator and for mmap_allocator with and without huge pages.
+ * TLB misses read "n/a" where perf events are not permitted.
+ */
+
+struct Buffer {
+	int idx;
+	char buff[4096];
+};
+
+template<class Allocator>
+void run(const char *name, std::size_t count) {
+	ft::vector<Buffer, Allocator> v;
+	bench::timer timer;
+	std::size_t reallocations = 0;
+	for (std::size_t i = 0; i < count; i++) {
+		if (v.size() == v.capacity())
+			reallocations++;
+		v.push_back(Buffer());
+	}
+	double grow_ms = timer.elapsed_ms();
+
+	std::srand(42);
+	long sum = 0;
+	bench::perf_counter tlb(bench::perf_counter::DTLB_MISSES);
+	timer.reset();
+	tlb.start();
+	for (std::size_t i = 0; i < count * 4; i++)
+		sum += v[std::rand() % count].buff[std::rand() % 4096];
+	long long misses = tlb.stop();
+	double read_ms = timer.elapsed_ms();
+	bench::do_not_optimize(sum);
+
+	char extra[160];
+	if (misses >= 0)
+		std::snprintf(extra, sizeof(extra), "reallocations: %3lu  random reads: %8.2f ms  dTLB misses: %lld",
+					  (unsigned long) reallocations, read_ms, misses);
+	else
+		std::snprintf(extra, sizeof(extra), "reallocations: %3lu  random reads: %8.2f ms  dTLB misses: n/a",
+					  (unsigned long) reallocations, read_ms);
+	bench::print_row(name, grow_ms, extra);
+}
+
+int main(int argc, char **argv) {
+	std::size_t megabytes = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 512;
+	std::size_t count = megabytes * 1024 * 1024 / sizeof(Buffer);
+
+	std::printf("push_back growth to %lu MB of Buffers (%lu elements)\n", (unsigned long) megabytes,
+				(unsigned long) count);
+	run<std::allocator<Buffer> >("std::allocator", count);
+	run<ft::mmap_allocator<Buffer> >("mmap_allocator", count);
+	run<ft::mmap_allocator<Buffer, true> >("mmap_allocator<HugePages>", count);
+	return 0;
+}
@@ -0,0 +1,65 @@
+#include <bench.hpp>
+#include <map.hpp>
+#include <map>
+#include <cstdlib>
+
+/*
+ * Builds a tree of COUNT nodes (10^7 by default) from ascending and from random
+ * keys, then clears it, timing both phases. Insertion, rebalancing and teardown
+ * all run without recursion, so the stack stays flat at any size.
+ */
+
+typedef ft::pair<const int, int> value_type;
+typedef ft::map<int, int>::tree_type tree_type;
+
+void run(const char *name, const ft::vector<int> &keys) {
+	tree_type tree;
+	bench::timer timer;
+	for (std::size_t i = 0; i < keys.size(); i++)
+		tree.insert_unique(value_type(keys[i], 0));
+	double insert_ms = timer.elapsed_ms();
+
+	timer.reset();
+	tree.clear();
+	double clear_ms = timer.elapsed_ms();
+
+	char extra[96];
+	std::snprintf(extra, sizeof(extra), "insert: %9.2f ms  clear: %9.2f ms", insert_ms, clear_ms);
+	bench::print_row(name, insert_ms + clear_ms, extra);
+}
+
+void run_std(const char *name, const ft::vector<int> &keys) {
+	std::map<int, int> *m = new std::map<int, int>();
+	bench::timer timer;
+	for (std::size_t i = 0; i < keys.size(); i++)
+		m->insert(std::make_pair(keys[i], 0));
+	double insert_ms = timer.elapsed_ms();
+
+	timer.reset();
+	delete m;
+	double clear_ms = timer.elapsed_ms();
+
+	char extra[96];
+	std::snprintf(extra, sizeof(extra), "insert: %9.2f ms  clear: %9.2f ms", insert_ms, clear_ms);
+	bench::print_row(name, insert_ms + clear_ms, extra);
+}
+
+int main(int argc, char **argv) {
+	std::size_t count = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 10000000;
+
+	ft::vector<int> ascending, random;
+	ascending.reserve(count);
+	random.reserve(count);
+	std::srand(42);
+	for (std::size_t i = 0; i < count; i++) {
+		ascending.push_back((int) i);
+		random.push_back(std::rand());
+	}
+
+	std::printf("%lu nodes\n", (unsigned long) count);
+	run("RBTree, ascending keys", ascending);
+	run("RBTree, random keys", random);
+	run_std("std::map, ascending keys", ascending);
+	run_std("std::map, random keys", random);
+	return 0;
+}
@@ -0,0 +1,46 @@
+#include <bench.hpp>
+#include <small_vector.hpp>
+#include <stack.hpp>
+#include <cstdlib>
+
+/*
+ * Builds ROUNDS short-lived containers of 1 to 16 ints, the way hot paths use them,
+ * and reports time and allocator calls for ft::vector against ft::small_vector.
+ */
+
+template<class Container>
+void run(const char *name, std::size_t rounds) {
+	bench::alloc_stats &stats = bench::alloc_stats::instance();
+	stats.reset();
+	std::srand(42);
+
+	long sum = 0;
+	bench::timer timer;
+	for (std::size_t i = 0; i < rounds; i++) {
+		ft::stack<int, Container> stack;
+		int n = std::rand() % 16 + 1;
+		for (int j = 0; j < n; j++)
+			stack.push(j);
+		while (!stack.empty()) {
+			sum += stack.top();
+			stack.pop();
+		}
+	}
+	double ms = timer.elapsed_ms();
+	bench::do_not_optimize(sum);
+
+	char extra[128];
+	std::snprintf(extra, sizeof(extra), "allocations: %9lu  bytes allocated: %lu",
+				  (unsigned long) stats.allocations, (unsigned long) stats.bytes_allocated);
+	bench::print_row(name, ms, extra);
+}
+
+int main(int argc, char **argv) {
+	std::size_t rounds = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 1000000;
+
+	std::printf("%lu stacks of 1 to 16 ints\n", (unsigned long) rounds);
+	run<ft::vector<int, bench::counting_allocator<int> > >("vector", rounds);
+	run<ft::small_vector<int, 8, bench::counting_allocator<int> > >("small_vector<8>", rounds);
+	run<ft::small_vector<int, 16, bench::counting_allocator<int> > >("small_vector<16>", rounds);
+	return 0;
+}
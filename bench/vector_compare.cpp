@@ -0,0 +1,64 @@
+#include <bench.hpp>
+#include <vector.hpp>
+#include <cstdlib>
+
+/*
+ * Compares two COUNT-element int vectors that only differ in the last element,
+ * ROUNDS times, with operator== and operator<. The "element-wise" rows are the
+ * old one-element-at-a-time loops, the others go through the memcmp/SIMD paths.
+ */
+
+template<class It>
+bool equal_elementwise(It lit, It lend, It rit, It rend) {
+	for (; lit != lend && rit != rend; ++lit, ++rit)
+		if (!(*lit == *rit))
+			return false;
+	return lit == lend && rit == rend;
+}
+
+template<class It>
+bool less_elementwise(It first1, It last1, It first2, It last2) {
+	for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
+		if (*first1 < *first2) return true;
+		if (*first2 < *first1) return false;
+	}
+	return first1 == last1 && first2 != last2;
+}
+
+int main(int argc, char **argv) {
+	std::size_t count = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 1000000;
+	std::size_t rounds = argc > 2 ? std::strtoul(argv[2], NULL, 10) : 200;
+
+	ft::vector<int> a(count), b(count);
+	for (std::size_t i = 0; i < count; i++)
+		a[i] = b[i] = static_cast<int>(i);
+	b[count - 1] += 1;
+
+	std::printf("%lu ints, %lu rounds\n", (unsigned long) count, (unsigned long) rounds);
+	bench::timer timer;
+	std::size_t hits = 0;
+
+	for (std::size_t r = 0; r < rounds; r++)
+		hits += equal_elementwise(a.begin(), a.end(), b.begin(), b.end());
+	bench::do_not_optimize(hits);
+	bench::print_row("equal, element-wise", timer.elapsed_ms(), "");
+
+	timer.reset();
+	for (std::size_t r = 0; r < rounds; r++)
+		hits += a == b;
+	bench::do_not_optimize(hits);
+	bench::print_row("operator==", timer.elapsed_ms(), "");
+
+	timer.reset();
+	for (std::size_t r = 0; r < rounds; r++)
+		hits += less_elementwise(a.begin(), a.end(), b.begin(), b.end());
+	bench::do_not_optimize(hits);
+	bench::print_row("lexicographical_compare, element-wise", timer.elapsed_ms(), "");
+
+	timer.reset();
+	for (std::size_t r = 0; r < rounds; r++)
+		hits += a < b;
+	bench::do_not_optimize(hits);
+	bench::print_row("operator<", timer.elapsed_ms(), "");
+	return 0;
+}
@@ -0,0 +1,56 @@
+#include <bench.hpp>
+#include <vector.hpp>
+#include <cstdlib>
+
+/*
+ * The src/main.cpp scenario: fill MEGABYTES worth of 4 KB Buffers, then write the
+ * idx of random elements. Compares push_back, resize and resize_default_init, and
+ * reports time and page faults for the fill and for the whole run.
+ */
+
+#define BUFFER_SIZE 4096
+struct Buffer {
+	int idx;
+	char buff[BUFFER_SIZE];
+};
+
+enum strategy { PUSH_BACK, RESIZE, DEFAULT_INIT };
+
+void run(const char *name, strategy s, std::size_t count) {
+	std::srand(42);
+	long faults = bench::page_faults();
+	bench::timer timer;
+
+	ft::vector<Buffer> v;
+	if (s == PUSH_BACK) {
+		for (std::size_t i = 0; i < count; i++)
+			v.push_back(Buffer());
+	} else if (s == RESIZE) {
+		v.resize(count);
+	} else {
+		v.resize_default_init(count);
+	}
+	double fill_ms = timer.elapsed_ms();
+	long fill_faults = bench::page_faults() - faults;
+
+	for (std::size_t i = 0; i < count; i++)
+		v[std::rand() % count].idx = 5;
+	bench::do_not_optimize(v);
+
+	char extra[128];
+	std::snprintf(extra, sizeof(extra), "fill: %9.2f ms %9ld faults  total faults: %ld",
+				  fill_ms, fill_faults, bench::page_faults() - faults);
+	bench::print_row(name, timer.elapsed_ms(), extra);
+}
+
+int main(int argc, char **argv) {
+	std::size_t megabytes = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 512;
+	std::size_t count = megabytes * 1024 * 1024 / sizeof(Buffer);
+
+	std::printf("%lu MB of %lu-byte Buffers (%lu elements)\n", (unsigned long) megabytes,
+				(unsigned long) sizeof(Buffer), (unsigned long) count);
+	run("push_back", PUSH_BACK, count);
+	run("resize", RESIZE, count);
+	run("resize_default_init", DEFAULT_INIT, count);
+	return 0;
+}
@@ -0,0 +1,62 @@
+#include <bench.hpp>
+#include <vector.hpp>
+#include <cstdlib>
+
+/*
+ * Appends COUNT elements with push_back under several growth policies and reports
+ * how many times the buffer was reallocated and how many bytes were copied on the
+ * way. With push_back alone every reallocation happens on a full buffer, so the
+ * bytes copied are the bytes released before the final buffer.
+ */
+
+struct Buffer {
+	int idx;
+	char buff[4096];
+};
+
+// The pre-policy behaviour: grow to exactly the required capacity.
+struct growth_exact {
+	static std::size_t next_capacity(std::size_t, std::size_t required, std::size_t) { return required; }
+};
+
+template<class T, class Growth>
+void run(const char *name, std::size_t count) {
+	typedef ft::vector<T, bench::counting_allocator<T>, Growth> vector_type;
+
+	bench::alloc_stats &stats = bench::alloc_stats::instance();
+	stats.reset();
+
+	bench::timer timer;
+	std::size_t copied;
+	{
+		vector_type v;
+		for (std::size_t i = 0; i < count; i++)
+			v.push_back(T());
+		copied = stats.bytes_deallocated;
+		bench::do_not_optimize(v);
+	}
+	double ms = timer.elapsed_ms();
+
+	char extra[128];
+	std::snprintf(extra, sizeof(extra), "reallocations: %8lu  bytes copied: %14lu",
+				  (unsigned long) stats.allocations, (unsigned long) copied);
+	bench::print_row(name, ms, extra);
+}
+
+int main(int argc, char **argv) {
+	std::size_t count = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 20000;
+
+	std::printf("push_back of %lu ints\n", (unsigned long) count);
+	run<int, growth_exact>("exact (before)", count);
+	run<int, ft::growth_one_and_half>("growth_one_and_half", count);
+	run<int, ft::growth_double>("growth_double", count);
+	run<int, ft::growth_page_aligned<> >("growth_page_aligned", count);
+
+	count /= 40;
+	std::printf("push_back of %lu 4 KB Buffers\n", (unsigned long) count);
+	run<Buffer, growth_exact>("exact (before)", count);
+	run<Buffer, ft::growth_one_and_half>("growth_one_and_half", count);
+	run<Buffer, ft::growth_double>("growth_double", count);
+	run<Buffer, ft::growth_page_aligned<> >("growth_page_aligned", count);
+	return 0;
+}
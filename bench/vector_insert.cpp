@@ -0,0 +1,73 @@
+#include <bench.hpp>
+#include <vector.hpp>
+#include <cstdlib>
+
+/*
+ * Inserts INSERTS single elements at the front, middle and back of a vector that
+ * holds COUNT ints at exactly full capacity, so the first insert has to grow the
+ * buffer. Each position runs twice: once through the pre-change path, which copied
+ * the whole vector into a temporary on every insert, and once through insert().
+ * Reports time, allocations and the peak bytes held during the inserts.
+ */
+
+typedef ft::vector<int, bench::counting_allocator<int> > vector_type;
+
+enum where { FRONT, MIDDLE, BACK };
+
+/*
+ * The pre-change insert: copy the vector into a temporary, grow through the growth
+ * policy, then rebuild the tail element by element from the copy.
+ */
+void insert_through_temporary(vector_type &v, std::size_t i, int val) {
+	vector_type tmp(v);
+
+	v.push_back(val);
+	v[i] = val;
+	for (std::size_t j = i + 1; j < v.size(); ++j)
+		v[j] = tmp[j - 1];
+}
+
+void run(const char *name, where w, bool through_temporary, std::size_t count, std::size_t inserts) {
+	vector_type v;
+	v.reserve(count);
+	for (std::size_t i = 0; i < count; i++)
+		v.push_back((int) i);
+
+	bench::alloc_stats &stats = bench::alloc_stats::instance();
+	stats.reset();
+
+	bench::timer timer;
+	for (std::size_t i = 0; i < inserts; i++) {
+		std::size_t index = v.size();
+		if (w == FRONT)
+			index = 0;
+		else if (w == MIDDLE)
+			index = v.size() / 2;
+		if (through_temporary)
+			insert_through_temporary(v, index, (int) i);
+		else
+			v.insert(v.begin() + index, (int) i);
+	}
+	double ms = timer.elapsed_ms();
+	bench::do_not_optimize(v);
+
+	char extra[160];
+	std::snprintf(extra, sizeof(extra), "allocations: %6lu  bytes allocated: %12lu  peak bytes: %10lu",
+				  (unsigned long) stats.allocations, (unsigned long) stats.bytes_allocated,
+				  (unsigned long) stats.peak_bytes);
+	bench::print_row(name, ms, extra);
+}
+
+int main(int argc, char **argv) {
+	std::size_t count = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 1000000;
+	std::size_t inserts = argc > 2 ? std::strtoul(argv[2], NULL, 10) : 1000;
+
+	std::printf("%lu inserts into a full vector of %lu ints\n", (unsigned long) inserts, (unsigned long) count);
+	run("front, copy through temporary (before)", FRONT, true, count, inserts);
+	run("front, insert", FRONT, false, count, inserts);
+	run("middle, copy through temporary (before)", MIDDLE, true, count, inserts);
+	run("middle, insert", MIDDLE, false, count, inserts);
+	run("back, copy through temporary (before)", BACK, true, count, inserts);
+	run("back, insert", BACK, false, count, inserts);
+	return 0;
+}
@@ -1,11 +1,36 @@
 #ifndef FT_CONTAINERS_FT_ALGORITHM_HPP
 #define FT_CONTAINERS_FT_ALGORITHM_HPP
 
-#include <type_traits>
 #include <algorithm>
+#include <cstring>
+#if defined(__AVX2__)
+# include <immintrin.h>
+#elif defined(__SSE2__)
+# include <emmintrin.h>
+#endif
+#if __cplusplus >= 201103L
+# include <utility>
+# include <type_traits>
+#endif
 
 namespace ft {
 
+	/*
+	 * ft::move casts to an rvalue when the compiler knows about them and is a no-op
+	 * in C++98, so relocation code can be written once for both standards.
+	 */
+#if __cplusplus >= 201103L
+	template<class T>
+	typename std::remove_reference<T>::type &&move(T &&x) {
+		return static_cast<typename std::remove_reference<T>::type &&>(x);
+	}
+#else
+	template<class T>
+	T &move(T &x) {
+		return x;
+	}
+#endif
+
 	template <class U, class X>
 	bool equal(U lit, U lend, X rit, X rend) {
 		while (lit != lend) {
@@ -23,7 +48,7 @@ namespace ft {
 		typedef R 	result_type;
 	};
 
-	template<typename T>
+	template<typename T = void>
 	struct less: public binary_function<T, T, bool>
 	{
 		bool operator()(const T& x, const T& y) const {
@@ -31,6 +56,55 @@ namespace ft {
 		}
 	};
 
+	/*
+	 * less<void> compares any two types that have an operator< between them. It is
+	 * transparent: map and set lookups with it accept any key type comparable with
+	 * their own, instead of converting the argument to key_type first.
+	 */
+	template<>
+	struct less<void>
+	{
+		typedef void is_transparent;
+
+		template<typename T, typename U>
+		bool operator()(const T& x, const U& y) const {
+			return x < y;
+		}
+	};
+
+	// Detects Compare::is_transparent, which opts a comparator into heterogeneous lookup.
+	template<typename Compare>
+	struct __is_transparent {
+	private:
+		template<typename U>
+		static char test(typename U::is_transparent *);
+
+		template<typename U>
+		static long test(...);
+
+	public:
+		static const bool value = sizeof(test<Compare>(0)) == sizeof(char);
+	};
+
+	// Key extractors for RBTree: the whole value (set) or the first member (map).
+	template<typename T>
+	struct identity {
+		typedef T result_type;
+
+		const T& operator()(const T& x) const {
+			return x;
+		}
+	};
+
+	template<typename Pair>
+	struct select1st {
+		typedef typename Pair::first_type result_type;
+
+		const result_type& operator()(const Pair& x) const {
+			return x.first;
+		}
+	};
+
 	template <typename _Tp, _Tp __v>
 	struct integral_constant
 	{
@@ -89,12 +163,68 @@ namespace ft {
 	template <typename T>
 	struct is_integral : public __is_integral_helper<T> { };
 
+	/*
+	 * A type is trivially relocatable when moving an object to a new address can be
+	 * done with a plain memcpy, leaving the source without running its destructor.
+	 * Every POD type qualifies; other types can opt in by specializing this trait.
+	 */
+	template <typename T>
+	struct is_trivially_relocatable : public integral_constant<bool, __is_pod(T)> { };
+
+	/*
+	 * Clang deprecates the __has_trivial_* builtins, so C++98 builds on clang use the
+	 * __is_trivially_* spellings and GCC keeps the older ones. The same applies to
+	 * is_trivially_default_constructible below.
+	 */
+#if __cplusplus >= 201103L
+	template <typename T>
+	struct is_trivially_destructible
+			: public integral_constant<bool, std::is_trivially_destructible<T>::value> { };
+#elif defined(__clang__)
+	template <typename T>
+	struct is_trivially_destructible : public integral_constant<bool, __is_trivially_destructible(T)> { };
+#else
+	template <typename T>
+	struct is_trivially_destructible : public integral_constant<bool, __has_trivial_destructor(T)> { };
+#endif
+
+#if __cplusplus >= 201103L
+	template <typename T>
+	struct is_trivially_default_constructible
+			: public integral_constant<bool, std::is_trivially_default_constructible<T>::value> { };
+#elif defined(__clang__)
+	template <typename T>
+	struct is_trivially_default_constructible : public integral_constant<bool, __is_trivially_constructible(T)> { };
+#else
+	template <typename T>
+	struct is_trivially_default_constructible : public integral_constant<bool, __has_trivial_constructor(T)> { };
+#endif
+
+	/*
+	 * Allocators that provide reallocate(p, old_n, new_n), moving a buffer of trivially
+	 * relocatable elements to a new size, specialize this to true_type.
+	 */
+	template <typename Alloc>
+	struct allocator_can_reallocate : public false_type { };
+
 	template<bool B, class T = void>
 	struct enable_if {};
 
 	template<class T>
 	struct enable_if<true, T> { typedef T type; };
 
+	template<class T, class U>
+	struct is_same : public false_type { };
+
+	template<class T>
+	struct is_same<T, T> : public true_type { };
+
+	template<class T>
+	struct remove_const { typedef T type; };
+
+	template<class T>
+	struct remove_const<const T> { typedef T type; };
+
 	template<class T>
 	const T& min(const T& a, const T& b) {
 		return (a < b ? a : b);
@@ -102,9 +232,9 @@ namespace ft {
 
 	template<class T>
 	void swap(T& a, T& b) {
-		T tmp(a);
-		a = b;
-		b = tmp;
+		T tmp(ft::move(a));
+		a = ft::move(b);
+		b = ft::move(tmp);
 	}
 
 	template<class T, class U>
@@ -121,6 +251,82 @@ namespace ft {
 		return first2 != last2;
 	}
 
+	/*
+	 * Contiguous ranges of the same integral type compare equal exactly when their
+	 * bytes do, so equal and lexicographical_compare over pointers first look for the
+	 * first differing byte with SSE2/AVX2 (or memcmp) and only then compare elements.
+	 * Everything else, floating point included, keeps the element-wise loops above.
+	 */
+	inline std::size_t __mismatch_bytes(const unsigned char *a, const unsigned char *b, std::size_t n) {
+		std::size_t i = 0;
+#if defined(__AVX2__)
+		for (; i + 32 <= n; i += 32) {
+			__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+			__m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+			unsigned int mask = ~static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+			if (mask)
+				return i + __builtin_ctz(mask);
+		}
+#endif
+#if defined(__SSE2__)
+		for (; i + 16 <= n; i += 16) {
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+			__m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+			unsigned int mask = ~static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) & 0xFFFFu;
+			if (mask)
+				return i + __builtin_ctz(mask);
+		}
+#endif
+		for (; i < n; ++i)
+			if (a[i] != b[i])
+				return i;
+		return n;
+	}
+
+	template<class T, class U>
+	struct __is_bitwise_comparable
+			: public integral_constant<bool, is_same<typename remove_const<T>::type, typename remove_const<U>::type>::value
+											 && is_integral<typename remove_const<T>::type>::value> { };
+
+	template<class T, class U>
+	bool __equal(T *lit, T *lend, U *rit, U *rend, true_type) {
+		return lend - lit == rend - rit
+			   && (lit == lend || std::memcmp(static_cast<const void *>(lit), static_cast<const void *>(rit),
+											  (lend - lit) * sizeof(T)) == 0);
+	}
+
+	template<class T, class U>
+	bool __equal(T *lit, T *lend, U *rit, U *rend, false_type) {
+		return ft::equal<T *, U *>(lit, lend, rit, rend);
+	}
+
+	template<class T, class U>
+	bool equal(T *lit, T *lend, U *rit, U *rend) {
+		return ft::__equal(lit, lend, rit, rend, __is_bitwise_comparable<T, U>());
+	}
+
+	template<class T, class U>
+	bool __lexicographical_compare(T *first1, T *last1, U *first2, U *last2, true_type) {
+		std::size_t n1 = last1 - first1;
+		std::size_t n2 = last2 - first2;
+		std::size_t n = n1 < n2 ? n1 : n2;
+		std::size_t i = ft::__mismatch_bytes(reinterpret_cast<const unsigned char *>(first1),
+											 reinterpret_cast<const unsigned char *>(first2), n * sizeof(T)) / sizeof(T);
+		if (i < n)
+			return first1[i] < first2[i];
+		return n1 < n2;
+	}
+
+	template<class T, class U>
+	bool __lexicographical_compare(T *first1, T *last1, U *first2, U *last2, false_type) {
+		return ft::lexicographical_compare<T *, U *>(first1, last1, first2, last2);
+	}
+
+	template<class T, class U>
+	bool lexicographical_compare(T *first1, T *last1, U *first2, U *last2) {
+		return ft::__lexicographical_compare(first1, last1, first2, last2, __is_bitwise_comparable<T, U>());
+	}
+
 	template<class T1, class T2>
 	struct pair {
 
@@ -132,6 +338,7 @@ namespace ft {
 
 		pair() : first(), second() {};
 		pair(const T1& x, const T2& y) : first(x), second(y) {};
+		pair(const pair& p) : first(p.first), second(p.second) {};
 		template<class U1, class U2>
 		pair(const pair<U1, U2>& p) : first(p.first), second(p.second) {};
 
@@ -141,11 +348,28 @@ namespace ft {
 			return *this;
 		}
 
+#if __cplusplus >= 201103L
+		template<class U1, class U2>
+		pair(U1&& x, U2&& y) : first(std::forward<U1>(x)), second(std::forward<U2>(y)) {};
+		pair(pair&& p) noexcept(std::is_nothrow_move_constructible<T1>::value &&
+								std::is_nothrow_move_constructible<T2>::value)
+				: first(std::forward<T1>(p.first)), second(std::forward<T2>(p.second)) {};
+		template<class U1, class U2>
+		pair(pair<U1, U2>&& p) : first(std::forward<U1>(p.first)), second(std::forward<U2>(p.second)) {};
+
+		pair& operator=(pair&& other) noexcept(std::is_nothrow_move_assignable<T1>::value &&
+											   std::is_nothrow_move_assignable<T2>::value) {
+			first = std::forward<T1>(other.first);
+			second = std::forward<T2>(other.second);
+			return *this;
+		}
+#endif
+
 	};
 
 	template<class T1, class T2>
 	ft::pair<T1,T2> make_pair(T1 t, T2 u) {
-		return pair<T1, T2>(t, u);
+		return pair<T1, T2>(ft::move(t), ft::move(u));
 	}
 
 	template<class T1, class T2>
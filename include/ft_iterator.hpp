@@ -2,6 +2,7 @@
 #define FT_CONTAINERS_FT_ITERATOR_HPP
 
 #include <ft_algorithm.hpp>
+#include <iterator>
 
 namespace ft {
 
@@ -18,20 +19,11 @@ namespace ft {
 
 	template<typename T>
 	struct iterator_traits {
-		typedef std::ptrdiff_t difference_type;
-		typedef T value_type;
-		typedef T *pointer;
-		typedef T &reference;
-		typedef random_access_iterator_tag iterator_category;
-	};
-
-	template<typename T>
-	struct iterator_traits<const T> {
-		typedef std::ptrdiff_t difference_type;
-		typedef T value_type;
-		typedef const T *pointer;
-		typedef const T &reference;
-		typedef random_access_iterator_tag iterator_category;
+		typedef typename T::difference_type difference_type;
+		typedef typename T::value_type value_type;
+		typedef typename T::pointer pointer;
+		typedef typename T::reference reference;
+		typedef typename T::iterator_category iterator_category;
 	};
 
 	template<typename T>
@@ -52,6 +44,52 @@ namespace ft {
 		typedef random_access_iterator_tag iterator_category;
 	};
 
+	/*
+	 * Maps the iterator tags of the standard library onto ours, so that std::
+	 * iterators can be dispatched on with the same overloads.
+	 */
+	template<typename Tag>
+	struct __iterator_category_helper { typedef Tag type; };
+
+	template<>
+	struct __iterator_category_helper<std::input_iterator_tag> { typedef input_iterator_tag type; };
+
+	template<>
+	struct __iterator_category_helper<std::output_iterator_tag> { typedef output_iterator_tag type; };
+
+	template<>
+	struct __iterator_category_helper<std::forward_iterator_tag> { typedef forward_iterator_tag type; };
+
+	template<>
+	struct __iterator_category_helper<std::bidirectional_iterator_tag> { typedef bidirectional_iterator_tag type; };
+
+	template<>
+	struct __iterator_category_helper<std::random_access_iterator_tag> { typedef random_access_iterator_tag type; };
+
+	template<typename T>
+	typename __iterator_category_helper<typename iterator_traits<T>::iterator_category>::type
+	iterator_category(const T &) {
+		return typename __iterator_category_helper<typename iterator_traits<T>::iterator_category>::type();
+	}
+
+	template<typename T>
+	typename iterator_traits<T>::difference_type __distance(T first, T last, input_iterator_tag) {
+		typename iterator_traits<T>::difference_type n = 0;
+		for (; first != last; ++first)
+			n++;
+		return n;
+	}
+
+	template<typename T>
+	typename iterator_traits<T>::difference_type __distance(T first, T last, random_access_iterator_tag) {
+		return last - first;
+	}
+
+	template<typename T>
+	typename iterator_traits<T>::difference_type distance(T first, T last) {
+		return ft::__distance(first, last, ft::iterator_category(first));
+	}
+
 	template<typename T>
 	class reverse_iterator : public T {
 
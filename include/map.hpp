@@ -4,6 +4,7 @@
 #include <ft_algorithm.hpp>
 #include <rbtree.hpp>
 #include <vector.hpp>
+#include <stdexcept>
 
 namespace ft {
 
@@ -11,7 +12,8 @@ namespace ft {
 			class Key,
 			class T,
 			class Compare = ft::less<Key>,
-			class Allocator = std::allocator<ft::pair<const Key, T> >
+			class Allocator = std::allocator<ft::pair<const Key, T> >,
+			class Options = ft::rbtree_options<>
 	>
 	class map {
 
@@ -28,7 +30,7 @@ namespace ft {
 		typedef typename Allocator::pointer								pointer;
 		typedef typename Allocator::const_pointer						const_pointer;
 
-		class value_compare : public std::binary_function<value_type, value_type, bool> {
+		class value_compare : public ft::binary_function<value_type, value_type, bool> {
 		protected:
 			key_compare comp;
 		public:
@@ -42,19 +44,19 @@ namespace ft {
 
 		};
 
-		typedef rbtree_iterator<value_type, value_compare>				iterator;
-		typedef rbtree_iterator<const value_type, value_compare, true>	const_iterator;
-		typedef ft::reverse_iterator<iterator>							reverse_iterator;
-		typedef ft::reverse_iterator<const_iterator>					const_reverse_iterator;
-
-		typedef RBTree<value_type, value_compare> tree_type;
-		typedef RBNode<value_type> node_type;
+		typedef RBTree<value_type, key_compare, Allocator, Options, ft::select1st<value_type> > tree_type;
+		typedef typename tree_type::node_type node_type;
 		typedef node_type *node_pointer;
+		typedef typename Allocator::template rebind<tree_type>::other tree_allocator_type;
+
+		typedef rbtree_iterator<value_type, false, node_type>		iterator;
+		typedef rbtree_iterator<const value_type, true, node_type>	const_iterator;
+		typedef ft::reverse_iterator<iterator>										reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>								const_reverse_iterator;
 
 	protected:
 		tree_type *_tree;
-		std::allocator<tree_type> _tree_allocator;
-		key_compare _comparator;
+		tree_allocator_type _tree_allocator;
 		allocator_type _allocator;
 		size_type _size;
 
@@ -62,45 +64,66 @@ namespace ft {
 
 		map() : _allocator(Allocator()), _size(0) {
 			_tree = _tree_allocator.allocate(1);
-			_tree_allocator.construct(_tree);
+			new (_tree) tree_type(_allocator);
 		}
 
-		explicit map(const Compare &comp, const Allocator &alloc = Allocator()) : _comparator(comp), _allocator(alloc),
-																				  _size(0) {
+		explicit map(const Compare &comp, const Allocator &alloc = Allocator()) : _allocator(alloc), _size(0) {
 			_tree = _tree_allocator.allocate(1);
-			_tree_allocator.construct(_tree);
+			new (_tree) tree_type(_allocator, comp);
 		}
 
 		template<class U>
-		map(U first, U last, const Compare &comp = Compare(), const Allocator &alloc = Allocator()) : _comparator(comp),
-																									  _allocator(alloc),
-																									  _size(0) {
+		map(U first, U last, const Compare &comp = Compare(), const Allocator &alloc = Allocator())
+				: _allocator(alloc), _size(0) {
 			_tree = _tree_allocator.allocate(1);
-			_tree_allocator.construct(_tree);
-			while (first != last)
-				insert(*first++);
+			new (_tree) tree_type(_allocator, comp);
+			insert(first, last);
 		}
 
-		map(const map &other) : _comparator(other.key_comp()), _allocator(other.get_allocator()), _size(0) {
+		// Builds the tree in O(n) from a range that is already sorted and unique.
+		template<class U>
+		map(from_sorted_unique_t, U first, U last, const Compare &comp = Compare(),
+			const Allocator &alloc = Allocator()) : _allocator(alloc), _size(0) {
 			_tree = _tree_allocator.allocate(1);
-			_tree_allocator.construct(_tree);
-			const_iterator it = other.begin();
-			while (it != other.end())
-				insert(*it++);
+			new (_tree) tree_type(_allocator, comp);
+			_size = _tree->assign_sorted(first, last, ft::iterator_category(first));
 		}
 
-		~map() {
-			clear();
+		map(const map &other) : _allocator(other.get_allocator()), _size(other._size) {
+			_tree = _tree_allocator.allocate(1);
+			new (_tree) tree_type(*other._tree);
 		}
 
-		map &operator=(const map &other) {
+#if __cplusplus >= 201103L
+		map(map &&other) : _allocator(other._allocator), _size(other._size) {
+			_tree = _tree_allocator.allocate(1);
+			new (_tree) tree_type(_allocator, other.key_comp());
+			ft::swap(_tree, other._tree);
+			other._size = 0;
+		}
+
+		map &operator=(map &&other) {
+			if (this != &other) {
+				clear();
+				ft::swap(_tree, other._tree);
+				ft::swap(_size, other._size);
+			}
+			return *this;
+		}
+#endif
+
+		~map() {
 			_tree_allocator.destroy(_tree);
 			_tree_allocator.deallocate(_tree, 1);
+		}
 
-			_tree = _tree_allocator.allocate(1);
-			_tree_allocator.construct(_tree);
-			_size = 0;
-			insert(other.begin(), other.end());
+		map &operator=(const map &other) {
+			if (this != &other) {
+				// assign empties the tree first, so a throwing copy leaves it empty.
+				_size = 0;
+				_tree->assign(*other._tree);
+				_size = other._size;
+			}
 			return *this;
 		}
 
@@ -110,23 +133,24 @@ namespace ft {
 
 		T &at(const Key &key) {
 			node_pointer res = _tree->find(key);
-			if (res == nullptr) return res;
+			if (res == _tree->end())
+				throw std::out_of_range("map::at: key not found");
 			return res->data.second;
 		}
 
 		const T &at(const Key &key) const {
 			node_pointer res = _tree->find(key);
-			if (res == nullptr) return res;
+			if (res == _tree->end())
+				throw std::out_of_range("map::at: key not found");
 			return res->data.second;
 		}
 
+		// The mapped value is only default-constructed when the key is new.
 		T &operator[](const Key &key) {
-			value_type pair = ft::make_pair(key, T());
-			node_pointer res = _tree->find(pair);
-			if (res == end().base()) {
-				return insert(pair).first->second;
-			}
-			return res->data.second;
+			iterator it = lower_bound(key);
+			if (it == end() || _tree->key_comp()(key, it->first))
+				it = insert(it, value_type(key, T()));
+			return it->second;
 		}
 
 		iterator begin() { return iterator(_tree->begin()); }
@@ -155,141 +179,170 @@ namespace ft {
 		size_type max_size() const { return _tree->max_size(); }
 
 		ft::pair<iterator, bool> insert(const value_type &value) {
-			node_pointer node = _tree->find(value);
-			if (node != end().base())
-				return ft::make_pair(iterator(node), false);
-			node = _tree->insert(value);
-			_size++;
-			return ft::make_pair(iterator(node), true);
+			ft::pair<node_pointer, bool> res = _tree->insert_unique(value);
+			if (res.second)
+				_size++;
+			return ft::make_pair(iterator(res.first), res.second);
 		}
 
+#if __cplusplus >= 201103L
+		ft::pair<iterator, bool> insert(value_type &&value) {
+			ft::pair<node_pointer, bool> res = _tree->insert_unique(std::move(value));
+			if (res.second)
+				_size++;
+			return ft::make_pair(iterator(res.first), res.second);
+		}
+
+		template<class... Args>
+		ft::pair<iterator, bool> emplace(Args &&... args) {
+			return insert(value_type(std::forward<Args>(args)...));
+		}
+
+		template<class... Args>
+		ft::pair<iterator, bool> try_emplace(const key_type &key, Args &&... args) {
+			iterator it = lower_bound(key);
+			if (it != end() && !_tree->key_comp()(key, it->first))
+				return ft::make_pair(it, false);
+			return ft::make_pair(insert(it, value_type(key, mapped_type(std::forward<Args>(args)...))), true);
+		}
+
+		template<class... Args>
+		ft::pair<iterator, bool> try_emplace(key_type &&key, Args &&... args) {
+			iterator it = lower_bound(key);
+			if (it != end() && !_tree->key_comp()(key, it->first))
+				return ft::make_pair(it, false);
+			return ft::make_pair(insert(it, value_type(std::move(key), mapped_type(std::forward<Args>(args)...))), true);
+		}
+#endif
+
 		iterator insert(iterator hint, const value_type &value) {
-			(void) hint;
-			return insert(value).first;
+			ft::pair<node_pointer, bool> res = _tree->insert_unique(hint.base(), value);
+			if (res.second)
+				_size++;
+			return iterator(res.first);
 		}
 
+#if __cplusplus >= 201103L
+		iterator insert(iterator hint, value_type &&value) {
+			ft::pair<node_pointer, bool> res = _tree->insert_unique(hint.base(), std::move(value));
+			if (res.second)
+				_size++;
+			return iterator(res.first);
+		}
+#endif
+
 		template<class U>
 		void insert(U first, U last, typename enable_if<!ft::is_integral<U>::value, U>::type * = 0) {
-			while (first != last)
-				insert(*first++);
+			this->insert_range(first, last, ft::iterator_category(first));
 		}
 
 		ft::pair<iterator, iterator> equal_range(const Key &key) {
-			return ft::make_pair(iterator(lower_bound(key)), iterator(upper_bound(key)));
+			ft::pair<node_pointer, node_pointer> range = _tree->equal_range(key);
+			return ft::make_pair(iterator(range.first), iterator(range.second));
 		}
 
 		ft::pair<const_iterator, const_iterator> equal_range(const Key &key) const {
-			return ft::make_pair(const_iterator(lower_bound(key)), const_iterator(upper_bound(key)));
+			ft::pair<node_pointer, node_pointer> range = _tree->equal_range(key);
+			return ft::make_pair(const_iterator(range.first), const_iterator(range.second));
+		}
+
+		/*
+		 * The template lookups below only exist for a transparent Compare, such as
+		 * ft::less<void>: they pass key straight to the comparator, so it never has to
+		 * be converted to key_type.
+		 */
+		template<class K>
+		ft::pair<iterator, iterator> equal_range(const K &key, typename enable_if<__is_transparent<Compare>::value, K>::type * = 0) {
+			ft::pair<node_pointer, node_pointer> range = _tree->equal_range(key);
+			return ft::make_pair(iterator(range.first), iterator(range.second));
+		}
+
+		template<class K>
+		ft::pair<const_iterator, const_iterator> equal_range(const K &key, typename enable_if<__is_transparent<Compare>::value, K>::type * = 0) const {
+			ft::pair<node_pointer, node_pointer> range = _tree->equal_range(key);
+			return ft::make_pair(const_iterator(range.first), const_iterator(range.second));
 		}
 
 		iterator lower_bound(const Key &key) {
-			node_type *n;
-			node_type *res;
-			res = end().base();
-			if (!_size)
-				return iterator(res);
-			n = _tree->root();
-			while (1) {
-				if ((*n).data.first == key) {
-					res = n;
-					break;
-				} else if (!_comparator((*n).data.first, key)) {
-					res = n;
-					if (!n->left)
-						break;
-					n = n->left;
-				} else if (_comparator((*n).data.first, key)) {
-					if (!n->right)
-						break;
-					n = n->right;
-				}
-			}
-			return iterator(res);
+			return iterator(_tree->lower_bound(key));
 		}
 
 		const_iterator lower_bound(const Key &key) const {
-			node_type *n;
-			const node_type *res;
-			res = end().base();
-			if (!_size)
-				return const_iterator(res);
-			n = _tree->root();
-			while (1) {
-				if ((*n).data.first == key) {
-					res = n;
-					break;
-				} else if (!_comparator((*n).data.first, key)) {
-					res = n;
-					if (!n->left)
-						break;
-					n = n->left;
-				} else if (_comparator((*n).data.first, key)) {
-					if (!n->right)
-						break;
-					n = n->right;
-				}
-			}
-			return const_iterator(res);
+			return const_iterator(_tree->lower_bound(key));
 		}
 
 		iterator upper_bound(const Key &key) {
-			node_type *n;
-			node_type *res;
-			res = end().base();
-			if (!_size)
-				return iterator(res);
-			n = _tree->root();
-			while (1) {
-				if ((*n).data.first == key) {
-					if (!n->right)
-						break;
-					n = n->right;
-				} else if (!_comparator((*n).data.first, key)) {
-					res = n;
-					if (!n->left)
-						break;
-					n = n->left;
-				} else if (_comparator((*n).data.first, key)) {
-					if (!n->right)
-						break;
-					n = n->right;
-				}
-			}
-			return iterator(res);
+			return iterator(_tree->upper_bound(key));
 		}
 
 		const_iterator upper_bound(const Key &key) const {
-			node_type *n;
-			const node_type *res;
-			res = end().base();
-			if (!_size)
-				return const_iterator(res);
-			n = _tree->root();
-			while (1) {
-				if ((*n).data.first == key) {
-					if (!n->right)
-						break;
-					n = n->right;
-				} else if (!_comparator((*n).data.first, key)) {
-					res = n;
-					if (!n->left)
-						break;
-					n = n->left;
-				} else if (_comparator((*n).data.first, key)) {
-					if (!n->right)
-						break;
-					n = n->right;
-				}
-			}
-			return const_iterator(res);
+			return const_iterator(_tree->upper_bound(key));
+		}
+
+		template<class K>
+		iterator lower_bound(const K &key, typename enable_if<__is_transparent<Compare>::value, K>::type * = 0) {
+			return iterator(_tree->lower_bound(key));
+		}
+
+		template<class K>
+		const_iterator lower_bound(const K &key, typename enable_if<__is_transparent<Compare>::value, K>::type * = 0) const {
+			return const_iterator(_tree->lower_bound(key));
+		}
+
+		template<class K>
+		iterator upper_bound(const K &key, typename enable_if<__is_transparent<Compare>::value, K>::type * = 0) {
+			return iterator(_tree->upper_bound(key));
+		}
+
+		template<class K>
+		const_iterator upper_bound(const K &key, typename enable_if<__is_transparent<Compare>::value, K>::type * = 0) const {
+			return const_iterator(_tree->upper_bound(key));
 		}
 
 		iterator find(const Key &key) {
-			return iterator(_tree->find(ft::make_pair(key, T())));
+			return iterator(_tree->find(key));
 		}
 
 		const_iterator find(const Key &key) const {
-			return const_iterator(_tree->find(ft::make_pair(key, T())));
+			return const_iterator(_tree->find(key));
+		}
+
+		template<class K>
+		iterator find(const K &key, typename enable_if<__is_transparent<Compare>::value, K>::type * = 0) {
+			return iterator(_tree->find(key));
+		}
+
+		template<class K>
+		const_iterator find(const K &key, typename enable_if<__is_transparent<Compare>::value, K>::type * = 0) const {
+			return const_iterator(_tree->find(key));
+		}
+
+		/*
+		 * Looks up every key in [first, last) and writes an iterator to out for each,
+		 * end() for the missing ones. Lookups run interleaved in small groups, which
+		 * is much faster than a find() loop once the tree no longer fits in cache.
+		 */
+		template<class ForwardIt, class OutputIt>
+		OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) {
+			return _tree->template find_many<iterator>(first, last, out);
+		}
+
+		template<class ForwardIt, class OutputIt>
+		OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const {
+			return _tree->template find_many<const_iterator>(first, last, out);
+		}
+
+		// Order statistics, only available with rbtree_options<C, true>.
+		iterator nth(size_type k) {
+			return iterator(_tree->select(k));
+		}
+
+		const_iterator nth(size_type k) const {
+			return const_iterator(_tree->select(k));
+		}
+
+		size_type rank(const Key &key) const {
+			return _tree->rank(key);
 		}
 
 		void erase(iterator pos) {
@@ -307,6 +360,17 @@ namespace ft {
 			return 0;
 		}
 
+		template<class K>
+		size_type erase(const K &k, typename enable_if<__is_transparent<Compare>::value, K>::type * = 0) {
+			iterator found = find(k);
+			if (found != end()) {
+				_tree->remove(found.base());
+				_size--;
+				return 1;
+			}
+			return 0;
+		}
+
 		void erase(iterator first, iterator last) {
 			ft::vector<Key> keys;
 			for (iterator it = first; it != last; it++)
@@ -316,54 +380,103 @@ namespace ft {
 		}
 
 		size_type count(const Key &key) const {
-			size_type s = 0;
-			for (const_iterator it = begin(); it != end(); it++)
-				if ((*it).first == key)
-					s++;
-			return s;
+			return _tree->count(key);
 		}
 
+		template<class K>
+		size_type count(const K &key, typename enable_if<__is_transparent<Compare>::value, K>::type * = 0) const {
+			return _tree->count(key);
+		}
+
+		// Trees stay where they are, only the handles change hands.
 		void swap(map& other) {
-			map temp = *this;
-			*this = other;
-			other = temp;
+			ft::swap(_tree, other._tree);
+			ft::swap(_tree_allocator, other._tree_allocator);
+			ft::swap(_allocator, other._allocator);
+			ft::swap(_size, other._size);
+		}
+
+		key_compare key_comp() const { return _tree->key_comp(); }
+
+		value_compare value_comp() const { return value_compare(key_comp()); }
+
+	private:
+
+		template<class U>
+		void insert_range(U first, U last, ft::input_iterator_tag) {
+			while (first != last)
+				insert(end(), *first++);
 		}
 
-		key_compare key_comp() const { return Compare(); }
+		/*
+		 * An empty container filled from a sorted, duplicate-free range gets the same
+		 * tree as from_sorted_unique would build. Checking costs one pass of n - 1
+		 * comparisons, which the per-element inserts would have paid many times over.
+		 */
+		template<class U>
+		void insert_range(U first, U last, ft::forward_iterator_tag) {
+			size_type n;
+			if (!_size && (n = this->sorted_length(first, last))) {
+				_tree->assign_sorted(first, n);
+				_size = n;
+				return;
+			}
+			this->insert_range(first, last, ft::input_iterator_tag());
+		}
 
-		value_compare value_comp() const { return value_compare(); }
+		/*
+		 * Length of [first, last) if its keys are strictly increasing, 0 otherwise.
+		 * Only the keys are compared: going through value_compare would convert each
+		 * pair<K, V> element to a value_type and copy its mapped value.
+		 */
+		template<class U>
+		size_type sorted_length(U first, U last) const {
+			if (first == last)
+				return 0;
+			const key_compare &comp = _tree->key_comp();
+			size_type n = 1;
+			for (U prev = first++; first != last; prev = first++, ++n)
+				if (!comp((*prev).first, (*first).first))
+					return 0;
+			return n;
+		}
 	};
 
-	template<class Key, class T, class Compare, class Alloc>
-	bool operator==(const ft::map<Key, T, Compare, Alloc> &lhs, const ft::map<Key, T, Compare, Alloc> &rhs) {
+	template<class Key, class T, class Compare, class Alloc, class Options>
+	bool operator==(const ft::map<Key, T, Compare, Alloc, Options> &lhs, const ft::map<Key, T, Compare, Alloc, Options> &rhs) {
 		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
 	}
 
-	template<class Key, class T, class Compare, class Alloc>
-	bool operator!=(const ft::map<Key, T, Compare, Alloc> &lhs, const ft::map<Key, T, Compare, Alloc> &rhs) {
+	template<class Key, class T, class Compare, class Alloc, class Options>
+	bool operator!=(const ft::map<Key, T, Compare, Alloc, Options> &lhs, const ft::map<Key, T, Compare, Alloc, Options> &rhs) {
 		return (!(lhs == rhs));
 	}
 
-	template<class Key, class T, class Compare, class Alloc>
-	bool operator<(const ft::map<Key, T, Compare, Alloc> &lhs, const ft::map<Key, T, Compare, Alloc> &rhs) {
+	template<class Key, class T, class Compare, class Alloc, class Options>
+	bool operator<(const ft::map<Key, T, Compare, Alloc, Options> &lhs, const ft::map<Key, T, Compare, Alloc, Options> &rhs) {
 		return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 	}
 
-	template<class Key, class T, class Compare, class Alloc>
-	bool operator<=(const ft::map<Key, T, Compare, Alloc> &lhs, const ft::map<Key, T, Compare, Alloc> &rhs) {
+	template<class Key, class T, class Compare, class Alloc, class Options>
+	bool operator<=(const ft::map<Key, T, Compare, Alloc, Options> &lhs, const ft::map<Key, T, Compare, Alloc, Options> &rhs) {
 		return (!(rhs < lhs));
 	}
 
-	template<class Key, class T, class Compare, class Alloc>
-	bool operator>(const ft::map<Key, T, Compare, Alloc> &lhs, const ft::map<Key, T, Compare, Alloc> &rhs) {
+	template<class Key, class T, class Compare, class Alloc, class Options>
+	bool operator>(const ft::map<Key, T, Compare, Alloc, Options> &lhs, const ft::map<Key, T, Compare, Alloc, Options> &rhs) {
 		return (rhs < lhs);
 	}
 
-	template<class Key, class T, class Compare, class Alloc>
-	bool operator>=(const ft::map<Key, T, Compare, Alloc> &lhs, const ft::map<Key, T, Compare, Alloc> &rhs) {
+	template<class Key, class T, class Compare, class Alloc, class Options>
+	bool operator>=(const ft::map<Key, T, Compare, Alloc, Options> &lhs, const ft::map<Key, T, Compare, Alloc, Options> &rhs) {
 		return (!(lhs < rhs));
 	}
 
+	template<class Key, class T, class Compare, class Alloc, class Options>
+	void swap(ft::map<Key, T, Compare, Alloc, Options> &x, ft::map<Key, T, Compare, Alloc, Options> &y) {
+		x.swap(y);
+	}
+
 
 }
 
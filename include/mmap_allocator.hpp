@@ -0,0 +1,136 @@
+#ifndef FT_CONTAINERS_MMAP_ALLOCATOR_HPP
+#define FT_CONTAINERS_MMAP_ALLOCATOR_HPP
+
+#include <ft_algorithm.hpp>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace ft {
+
+	/*
+	 * Allocator for multi-gigabyte buffers. Requests of at least Threshold bytes are
+	 * mapped straight from the kernel with mmap (optionally advised for transparent
+	 * huge pages), smaller ones go through operator new. reallocate() grows mapped
+	 * buffers with mremap, so ft::vector can grow trivially relocatable data
+	 * without copying it.
+	 */
+	template<class T, bool HugePages = false, std::size_t Threshold = 1024 * 1024>
+	class mmap_allocator {
+
+	public:
+		typedef T value_type;
+		typedef T *pointer;
+		typedef const T *const_pointer;
+		typedef T &reference;
+		typedef const T &const_reference;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+
+		template<class U>
+		struct rebind {
+			typedef mmap_allocator<U, HugePages, Threshold> other;
+		};
+
+		mmap_allocator() {}
+
+		mmap_allocator(const mmap_allocator &) {}
+
+		template<class U>
+		mmap_allocator(const mmap_allocator<U, HugePages, Threshold> &) {}
+
+		~mmap_allocator() {}
+
+		pointer address(reference x) const { return &x; }
+
+		const_pointer address(const_reference x) const { return &x; }
+
+		size_type max_size() const { return size_type(-1) / sizeof(T); }
+
+		void construct(pointer p, const T &val) { new (static_cast<void *>(p)) T(val); }
+
+#if __cplusplus >= 201103L
+		template<class U, class... Args>
+		void construct(U *p, Args &&... args) { new (static_cast<void *>(p)) U(std::forward<Args>(args)...); }
+#endif
+
+		void destroy(pointer p) { p->~T(); }
+
+		pointer allocate(size_type n, const void * = 0) {
+			if (n > max_size())
+				throw std::bad_alloc();
+			if (!is_mapped(n))
+				return static_cast<pointer>(::operator new(n * sizeof(T)));
+
+			void *p = mmap(NULL, mapping_size(n), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (p == MAP_FAILED)
+				throw std::bad_alloc();
+			advise(p, mapping_size(n));
+			return static_cast<pointer>(p);
+		}
+
+		void deallocate(pointer p, size_type n) {
+			if (!p) return;
+			if (is_mapped(n))
+				munmap(static_cast<void *>(p), mapping_size(n));
+			else
+				::operator delete(static_cast<void *>(p));
+		}
+
+		/*
+		 * Moves a buffer of old_n elements to one of new_n elements, keeping the first
+		 * min(old_n, new_n) elements bitwise. Only valid for trivially relocatable T.
+		 */
+		pointer reallocate(pointer p, size_type old_n, size_type new_n) {
+#ifdef MREMAP_MAYMOVE
+			if (p && is_mapped(old_n) && is_mapped(new_n)) {
+				void *q = mremap(static_cast<void *>(p), mapping_size(old_n), mapping_size(new_n), MREMAP_MAYMOVE);
+				if (q == MAP_FAILED)
+					throw std::bad_alloc();
+				advise(q, mapping_size(new_n));
+				return static_cast<pointer>(q);
+			}
+#endif
+			pointer q = allocate(new_n);
+			if (p) {
+				std::memcpy(static_cast<void *>(q), static_cast<const void *>(p), (old_n < new_n ? old_n : new_n) * sizeof(T));
+				deallocate(p, old_n);
+			}
+			return q;
+		}
+
+	private:
+		static bool is_mapped(size_type n) {
+			return n * sizeof(T) >= Threshold;
+		}
+
+		static size_type mapping_size(size_type n) {
+			size_type page = static_cast<size_type>(sysconf(_SC_PAGESIZE));
+			return (n * sizeof(T) + page - 1) / page * page;
+		}
+
+		static void advise(void *p, size_type length) {
+#ifdef MADV_HUGEPAGE
+			if (HugePages)
+				madvise(p, length, MADV_HUGEPAGE);
+#else
+			(void) p;
+			(void) length;
+#endif
+		}
+	};
+
+	template<class T, bool H, std::size_t S, class U>
+	bool operator==(const mmap_allocator<T, H, S> &, const mmap_allocator<U, H, S> &) { return true; }
+
+	template<class T, bool H, std::size_t S, class U>
+	bool operator!=(const mmap_allocator<T, H, S> &, const mmap_allocator<U, H, S> &) { return false; }
+
+	template<class T, bool H, std::size_t S>
+	struct allocator_can_reallocate<mmap_allocator<T, H, S> > : public true_type { };
+
+}
+
+#endif
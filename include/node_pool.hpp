@@ -0,0 +1,118 @@
+#ifndef FT_CONTAINERS_NODE_POOL_HPP
+#define FT_CONTAINERS_NODE_POOL_HPP
+
+#include <cstddef>
+#include <memory>
+
+namespace ft {
+
+	/*
+	 * Fixed-size storage for tree nodes. Memory comes from Alloc in chunks that double
+	 * in size up to MaxChunk nodes and is handed out front to back; freed nodes go on
+	 * an intrusive free list and are reused before the pool asks Alloc for more.
+	 * Chunks are only given back by release(), all at once. The pool hands out raw
+	 * storage: constructing and destroying nodes is left to the caller.
+	 */
+	template<class T, class Alloc = std::allocator<T>, std::size_t MaxChunk = 4096>
+	class node_pool {
+
+	public:
+		typedef T value_type;
+		typedef Alloc allocator_type;
+		typedef T *pointer;
+		typedef std::size_t size_type;
+
+	private:
+		struct free_node {
+			free_node *next;
+		};
+
+		struct chunk {
+			chunk *next;
+			size_type size;
+		};
+
+		static const size_type header_size = (sizeof(chunk) + sizeof(T) - 1) / sizeof(T);
+		static const size_type min_chunk = 32;
+
+		allocator_type _allocator;
+		chunk *_chunks;
+		free_node *_free;
+		pointer _next;
+		pointer _limit;
+		size_type _chunk_size;
+
+		node_pool(const node_pool &);
+		node_pool &operator=(const node_pool &);
+
+	public:
+		explicit node_pool(const allocator_type &alloc = allocator_type())
+				: _allocator(alloc), _chunks(NULL), _free(NULL), _next(NULL), _limit(NULL), _chunk_size(min_chunk) {}
+
+		~node_pool() {
+			release();
+		}
+
+		pointer allocate() {
+			if (_free) {
+				pointer p = reinterpret_cast<pointer>(_free);
+				_free = _free->next;
+				return p;
+			}
+			if (_next == _limit)
+				grow(_chunk_size);
+			return _next++;
+		}
+
+		/*
+		 * Makes sure n nodes are available contiguously past the free list: once the
+		 * free list is used up, the next n allocations come from one chunk. Whatever
+		 * is left of the current chunk goes on the free list. Callers that want all n
+		 * from the chunk release() an empty pool first.
+		 */
+		void reserve(size_type n) {
+			if (static_cast<size_type>(_limit - _next) >= n)
+				return;
+			while (_next != _limit)
+				deallocate(_next++);
+			grow(n);
+		}
+
+		void deallocate(pointer p) {
+			free_node *node = reinterpret_cast<free_node *>(p);
+			node->next = _free;
+			_free = node;
+		}
+
+		void release() {
+			while (_chunks) {
+				chunk *next = _chunks->next;
+				_allocator.deallocate(reinterpret_cast<pointer>(_chunks), _chunks->size);
+				_chunks = next;
+			}
+			_free = NULL;
+			_next = NULL;
+			_limit = NULL;
+			_chunk_size = min_chunk;
+		}
+
+		allocator_type get_allocator() const { return _allocator; }
+
+	private:
+		void grow(size_type n) {
+			size_type size = header_size + n;
+			pointer p = _allocator.allocate(size);
+			chunk *c = reinterpret_cast<chunk *>(p);
+			c->next = _chunks;
+			c->size = size;
+			_chunks = c;
+			_next = p + header_size;
+			_limit = p + size;
+			if (_chunk_size < MaxChunk)
+				_chunk_size *= 2;
+		}
+	};
+
+}
+
+#endif
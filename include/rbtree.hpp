@@ -2,97 +2,253 @@
 #define FT_CONTAINERS_RBTREE_HPP
 
 #include <iostream>
+#include <new>
+#include <ft_algorithm.hpp>
 #include <ft_iterator.hpp>
-#include <type_traits>
+#include <node_pool.hpp>
 
 namespace ft {
 
 	enum Color {
-		RED, BLACK, DOUBLE_BLACK
+		RED, BLACK
 	};
 
-	template<class T>
-	class RBNode {
+	/*
+	 * Layout switches for RBTree, passed down from map and set.
+	 * CompactColor keeps the node color in the low bit of the parent pointer instead
+	 * of a separate Color field, which saves the padding after it: a map<int, int>
+	 * or set<long> node goes from 40 to 32 bytes. Values of 4 bytes or less already
+	 * sit in that padding, so set<int> and set<char> nodes are 32 bytes either way
+	 * and gain nothing but the masking on every parent access.
+	 * OrderStatistics stores the size of every subtree in its root, which makes
+	 * nth(), rank() and ft::distance() between iterators O(log n). Without it the
+	 * nodes carry no extra field and the tree does no extra work.
+	 * Threaded links the nodes into a circular in-order list through the header, two
+	 * more pointers per node, so every iterator step is a single load instead of a
+	 * walk of up to O(log n) parent or child links.
+	 */
+	template<bool CompactColor = false, bool OrderStatistics = false, bool Threaded = false>
+	struct rbtree_options {
+		static const bool compact_color = CompactColor;
+		static const bool order_statistics = OrderStatistics;
+		static const bool threaded = Threaded;
+	};
+
+	/*
+	 * Tag for the map/set constructors that take a range the caller promises is
+	 * sorted and free of duplicates, so the tree can be built in one linear pass.
+	 */
+	struct from_sorted_unique_t {};
+
+	static const from_sorted_unique_t from_sorted_unique = from_sorted_unique_t();
+
+	template<class Node, bool Compact>
+	class rbnode_link;
+
+	template<class Node>
+	class rbnode_link<Node, false> {
+
+	private:
+		Node *_parent;
+		Color _color;
+
+	public:
+		explicit rbnode_link(Color color) : _parent(NULL), _color(color) {}
+
+		Node *parent() const { return _parent; }
+
+		void setParent(Node *parent) { _parent = parent; }
+
+		Color color() const { return _color; }
+
+		void setColor(Color color) { _color = color; }
+	};
+
+	// Nodes hold pointers, so their addresses always leave the low bit free.
+	template<class Node>
+	class rbnode_link<Node, true> {
+
+	private:
+		std::size_t _parent_color;
+
+	public:
+		explicit rbnode_link(Color color) : _parent_color(color) {}
+
+		Node *parent() const { return reinterpret_cast<Node *>(_parent_color & ~std::size_t(1)); }
+
+		void setParent(Node *parent) { _parent_color = reinterpret_cast<std::size_t>(parent) | (_parent_color & 1); }
+
+		Color color() const { return static_cast<Color>(_parent_color & 1); }
+
+		void setColor(Color color) { _parent_color = (_parent_color & ~std::size_t(1)) | color; }
+	};
+
+	template<bool Sized>
+	class rbnode_size {
+
+	public:
+		static const bool has_size = false;
+	};
+
+	template<>
+	class rbnode_size<true> {
+
+	private:
+		std::size_t _size;
+
+	public:
+		static const bool has_size = true;
+
+		rbnode_size() : _size(1) {}
+
+		std::size_t subtreeSize() const { return _size; }
+
+		void setSubtreeSize(std::size_t size) { _size = size; }
+	};
+
+	template<class Node, bool Threaded>
+	class rbnode_thread {
+
+	public:
+		static const bool has_thread = false;
+	};
+
+	template<class Node>
+	class rbnode_thread<Node, true> {
+
+	private:
+		Node *_next;
+		Node *_prev;
+
+	public:
+		static const bool has_thread = true;
+
+		rbnode_thread() : _next(NULL), _prev(NULL) {}
+
+		Node *next() const { return _next; }
+
+		Node *prev() const { return _prev; }
+
+		void setNext(Node *next) { _next = next; }
+
+		void setPrev(Node *prev) { _prev = prev; }
+	};
+
+	/*
+	 * The header of a tree (RBTree::end()) is a node too: its parent is the root and
+	 * the root's parent is the header, so a node is the root exactly when its parent
+	 * points back at it. The header is red and the root black, which tells the two
+	 * apart.
+	 */
+	template<class T, class Options = rbtree_options<> >
+	class RBNode : public rbnode_link<RBNode<T, Options>, Options::compact_color>,
+				   public rbnode_size<Options::order_statistics>,
+				   public rbnode_thread<RBNode<T, Options>, Options::threaded> {
 
 	public:
 		typedef T value_type;
-		typedef RBNode<T> *node_pointer;
+		typedef RBNode<T, Options> *node_pointer;
+		typedef rbnode_link<RBNode<T, Options>, Options::compact_color> link_type;
+		typedef rbnode_size<Options::order_statistics> size_base_type;
+		typedef rbnode_thread<RBNode<T, Options>, Options::threaded> thread_base_type;
 
 	public:
 		value_type data;
-		Color color;
-		node_pointer parent, left, right;
+		node_pointer left, right;
 
 	public:
 
 		RBNode(const value_type &data = value_type(), Color color = RED)
-				: data(data), color(color), parent(nullptr), left(nullptr), right(nullptr) {};
+				: link_type(color), data(data), left(NULL), right(NULL) {};
+
+#if __cplusplus >= 201103L
+		RBNode(value_type &&data, Color color = RED)
+				: link_type(color), data(std::move(data)), left(NULL), right(NULL) {};
+#endif
 
 		RBNode(const RBNode &other, const value_type &data)
-				: data(data), color(other.color), parent(other.parent), left(other.left), right(other.right) {}
+				: link_type(other), size_base_type(other), thread_base_type(other), data(data), left(other.left),
+				  right(other.right) {}
 
 		~RBNode() {};
 
-		bool isRoot() { return !parent; };
+		bool isRoot() const { return !this->parent() || this->parent()->parent() == this; };
 
-		bool isLeft() { return parent && parent->left == this; };
+		bool isHeader() const { return isRed() && this->parent() && this->parent()->parent() == this; };
 
-		bool isRight() { return parent && parent->right == this; };
+		bool isLeft() const { return !isRoot() && this->parent()->left == this; };
 
-		bool isRed() { return color == RED; };
+		bool isRight() const { return !isRoot() && this->parent()->right == this; };
 
-		bool isBlack() { return color == BLACK; };
+		bool isRed() const { return this->color() == RED; };
 
-		bool isDoubleBlack() { return color == DOUBLE_BLACK; };
+		bool isBlack() const { return this->color() == BLACK; };
 
 		node_pointer sibling() {
-			if (isRoot()) return nullptr;
-			if (isLeft()) return parent->right;
-			else return parent->left;
+			if (isRoot()) return NULL;
+			if (isLeft()) return this->parent()->right;
+			else return this->parent()->left;
 		};
 
 		node_pointer uncle() {
-			if (isRoot()) return nullptr;
-			return parent->getSibling();
+			if (isRoot()) return NULL;
+			return this->parent()->sibling();
 		};
 
 		node_pointer grandparent() {
-			if (isRoot()) return nullptr;
-			return parent->parent;
+			if (isRoot()) return NULL;
+			return this->parent()->parent();
 		};
 
 	};
 
-	template<class T, class U>
-	bool operator<(const ft::RBNode<T> &lhs, const ft::RBNode<U> &rhs) {
+	template<class T, class O, class U, class P>
+	bool operator<(const ft::RBNode<T, O> &lhs, const ft::RBNode<U, P> &rhs) {
 		return lhs.data < rhs.data;
 	}
 
+	// In-order index of node, end() included, from the subtree sizes on its path.
+	template<class Node>
+	std::size_t __rbtree_position(const Node *node) {
+		if (node->isHeader())
+			return node->parent()->subtreeSize();
+		std::size_t position = node->left ? node->left->subtreeSize() : 0;
+		for (; !node->isRoot(); node = node->parent())
+			if (node->isRight())
+				position += (node->parent()->left ? node->parent()->left->subtreeSize() : 0) + 1;
+		return position;
+	}
+
 
-	template<class T, class Compare = ft::less<T>, bool isConst = false>
+	/*
+	 * Steps follow the parent/child links only: the next node is the leftmost one of
+	 * the right subtree or, without one, the first ancestor reached from its left
+	 * side. No key is ever compared, so the iterator needs no comparator. Threaded
+	 * nodes already know their neighbours and are followed directly.
+	 */
+	template<class T, bool isConst = false, class Node = RBNode<typename iterator_traits<T *>::value_type> >
 	class rbtree_iterator {
 	public:
 		typedef T															iterator_type;
-		typedef typename iterator_traits<iterator_type>::value_type			value_type;
-		typedef typename iterator_traits<iterator_type>::difference_type	difference_type;
-		typedef typename iterator_traits<iterator_type>::pointer			pointer;
-		typedef typename iterator_traits<iterator_type>::reference			reference;
-		typedef typename iterator_traits<iterator_type>::iterator_category	iterator_category;
-		typedef RBNode<value_type>*											node_pointer;
+		typedef typename iterator_traits<iterator_type *>::value_type		value_type;
+		typedef typename iterator_traits<iterator_type *>::difference_type	difference_type;
+		typedef typename iterator_traits<iterator_type *>::pointer			pointer;
+		typedef typename iterator_traits<iterator_type *>::reference		reference;
+		typedef bidirectional_iterator_tag									iterator_category;
+		typedef Node*														node_pointer;
 
 	protected:
 		node_pointer ptr;
-		Compare compare;
 
 	public:
-		rbtree_iterator() : ptr(nullptr) {}
+		rbtree_iterator() : ptr(NULL) {}
 
 		rbtree_iterator(node_pointer ptr) : ptr(ptr) {}
 
-		rbtree_iterator(const RBNode<value_type> *ptr) : ptr(const_cast<node_pointer>(ptr)) {}
+		rbtree_iterator(const Node *ptr) : ptr(const_cast<node_pointer>(ptr)) {}
 
 		template<class U>
-		rbtree_iterator(const rbtree_iterator<U, Compare> &other) : ptr(const_cast<node_pointer>(other.base())) {}
+		rbtree_iterator(const rbtree_iterator<U, false, Node> &other) : ptr(const_cast<node_pointer>(other.base())) {}
 
 		~rbtree_iterator() {}
 
@@ -105,21 +261,8 @@ namespace ft {
 		pointer operator->() const { return &ptr->data; }
 
 		rbtree_iterator &operator++() {
-			if (ptr->right) {
-				ptr = ptr->right;
-				while (ptr->left)
-					ptr = ptr->left;
-			} else {
-				while (ptr->parent) {
-					if (!ptr->isDoubleBlack() && !compare(ptr->parent->data, ptr->data) && ptr->parent->data != ptr->data) {
-						ptr = ptr->parent;
-						return (*this);
-					}
-					ptr = ptr->parent;
-				}
-			}
+			increment(integral_constant<bool, Node::has_thread>());
 			return *this;
-
 		}
 
 		rbtree_iterator operator++(int) {
@@ -129,23 +272,7 @@ namespace ft {
 		}
 
 		rbtree_iterator &operator--() {
-
-			if (ptr->left) {
-				ptr = ptr->left;
-				while (ptr->right && !ptr->right->isDoubleBlack())
-					ptr = ptr->right;
-			} else {
-
-				while (ptr->parent) {
-
-					if (ptr->isDoubleBlack() || compare(ptr->parent->data, ptr->data)) {
-						ptr = ptr->parent;
-						return *this;
-					}
-
-					ptr = ptr->parent;
-				}
-			}
+			decrement(integral_constant<bool, Node::has_thread>());
 			return *this;
 		}
 
@@ -165,94 +292,267 @@ namespace ft {
 
 		node_pointer base() const { return ptr; }
 
-		Compare comparator() { return compare; }
+	private:
+		void increment(true_type) {
+			ptr = ptr->next();
+		}
+
+		void increment(false_type) {
+			if (ptr->right) {
+				ptr = ptr->right;
+				while (ptr->left)
+					ptr = ptr->left;
+			} else {
+				node_pointer parent = ptr->parent();
+				while (ptr == parent->right) {
+					ptr = parent;
+					parent = parent->parent();
+				}
+				// Leaving the rightmost node through a root without a right child
+				// climbs to the header and back; stop at the header all the same.
+				if (ptr->right != parent)
+					ptr = parent;
+			}
+		}
+
+		void decrement(true_type) {
+			ptr = ptr->prev();
+		}
+
+		void decrement(false_type) {
+			if (ptr->isHeader()) {
+				ptr = ptr->right;
+			} else if (ptr->left) {
+				ptr = ptr->left;
+				while (ptr->right)
+					ptr = ptr->right;
+			} else {
+				node_pointer parent = ptr->parent();
+				while (ptr == parent->left) {
+					ptr = parent;
+					parent = parent->parent();
+				}
+				ptr = parent;
+			}
+		}
 	};
 
-	template<class T, class Compare = ft::less<RBNode<T> >, class Alloc = std::allocator<RBNode<T> > >
+	template<class T, bool C, class Node>
+	typename rbtree_iterator<T, C, Node>::difference_type
+	__distance(rbtree_iterator<T, C, Node> first, rbtree_iterator<T, C, Node> last, true_type) {
+		if (first == last)
+			return 0;
+		return static_cast<typename rbtree_iterator<T, C, Node>::difference_type>(__rbtree_position(last.base()))
+			   - static_cast<typename rbtree_iterator<T, C, Node>::difference_type>(__rbtree_position(first.base()));
+	}
+
+	template<class T, bool C, class Node>
+	typename rbtree_iterator<T, C, Node>::difference_type
+	__distance(rbtree_iterator<T, C, Node> first, rbtree_iterator<T, C, Node> last, false_type) {
+		return ft::__distance(first, last, bidirectional_iterator_tag());
+	}
+
+	template<class T, bool C, class Node>
+	typename rbtree_iterator<T, C, Node>::difference_type
+	distance(rbtree_iterator<T, C, Node> first, rbtree_iterator<T, C, Node> last) {
+		return ft::__distance(first, last, integral_constant<bool, Node::has_size>());
+	}
+
+	/*
+	 * Values are ordered by Compare applied to the keys KeyOfValue pulls out of them
+	 * (the value itself for set, its first member for map). Lookups only take a key,
+	 * of any type Compare accepts, so they never have to build a value_type.
+	 */
+	template<class T, class Compare = ft::less<T>, class Alloc = std::allocator<T>,
+			class Options = rbtree_options<>, class KeyOfValue = ft::identity<T> >
 	class RBTree {
 
 	public:
 		typedef T value_type;
-		typedef Alloc allocator_type;
-		typedef typename allocator_type::size_type size_type;
-		typedef RBNode<T> node_type;
+		typedef typename KeyOfValue::result_type key_type;
+		typedef RBNode<T, Options> node_type;
 		typedef node_type *node_pointer;
+		typedef typename Alloc::template rebind<node_type>::other allocator_type;
+		typedef typename allocator_type::size_type size_type;
 
 	private:
-		node_pointer _root;
+		/*
+		 * _end is the header: its parent is the root, its left and right are the
+		 * leftmost and rightmost nodes (itself when empty) and the root's parent is
+		 * _end. It is never linked as a child, so begin() and end() are O(1) and
+		 * mutations only touch the extremes they actually change. It is kept red so
+		 * that iterators can tell it from the (black) root.
+		 */
 		allocator_type _allocator;
+		node_pool<node_type, allocator_type> _pool;
 		Compare _comparator;
 		node_pointer _end;
-		node_pointer _start;
 
 	protected:
 		Color getColor(node_pointer node) {
-			if (node == nullptr) return BLACK;
-			return node->color;
+			if (node == NULL) return BLACK;
+			return node->color();
 		}
 
 		void setColor(node_pointer node, Color color) {
-			if (node == nullptr) return;
-			node->color = color;
+			if (node == NULL) return;
+			node->setColor(color);
+		}
+
+		static const key_type &keyOf(const value_type &data) {
+			return KeyOfValue()(data);
+		}
+
+		typedef integral_constant<bool, Options::order_statistics> order_statistics;
+
+		static size_type subtreeSize(node_pointer node) {
+			return node ? node->subtreeSize() : 0;
+		}
+
+		void updateSize(node_pointer node, true_type) {
+			node->setSubtreeSize(subtreeSize(node->left) + subtreeSize(node->right) + 1);
+		}
+
+		void updateSize(node_pointer, false_type) {}
+
+		void updateSize(node_pointer node) {
+			updateSize(node, order_statistics());
+		}
+
+		// Recomputes the sizes from node up to the root.
+		void updatePathSizes(node_pointer node, true_type) {
+			for (; node != _end; node = node->parent())
+				updateSize(node, true_type());
+		}
+
+		void updatePathSizes(node_pointer, false_type) {}
+
+		void updatePathSizes(node_pointer node) {
+			updatePathSizes(node, order_statistics());
+		}
+
+		void swapSizes(node_pointer lhs, node_pointer rhs, true_type) {
+			size_type size = lhs->subtreeSize();
+			lhs->setSubtreeSize(rhs->subtreeSize());
+			rhs->setSubtreeSize(size);
+		}
+
+		void swapSizes(node_pointer, node_pointer, false_type) {}
+
+		typedef integral_constant<bool, Options::threaded> threaded;
+
+		// Puts a freshly linked leaf into the in-order list, next to its parent.
+		void threadNode(node_pointer parent, bool left, node_pointer node, true_type) {
+			node_pointer prev = left ? parent->prev() : parent;
+			node_pointer next = prev->next();
+			node->setPrev(prev);
+			node->setNext(next);
+			prev->setNext(node);
+			next->setPrev(node);
+		}
+
+		void threadNode(node_pointer, bool, node_pointer, false_type) {}
+
+		void threadNode(node_pointer parent, bool left, node_pointer node) {
+			threadNode(parent, left, node, threaded());
+		}
+
+		void unthreadNode(node_pointer node, true_type) {
+			node->prev()->setNext(node->next());
+			node->next()->setPrev(node->prev());
+		}
+
+		void unthreadNode(node_pointer, false_type) {}
+
+		void unthreadNode(node_pointer node) {
+			unthreadNode(node, threaded());
+		}
+
+		// Relinks the whole list in order, for trees built without linkNode.
+		void rethread(true_type) {
+			node_pointer prev = _end;
+			if (root())
+				for (node_pointer node = _end->left; node != _end; node = successor(node)) {
+					prev->setNext(node);
+					node->setPrev(prev);
+					prev = node;
+				}
+			prev->setNext(_end);
+			_end->setPrev(prev);
+		}
+
+		void rethread(false_type) {}
+
+		void rethread() {
+			rethread(threaded());
 		}
 
 		void rotateLeft(node_pointer ptr) {
 			node_pointer right_child = ptr->right;
 			ptr->right = right_child->left;
 
-			if (ptr->right != nullptr)
-				ptr->right->parent = ptr;
+			if (ptr->right != NULL)
+				ptr->right->setParent(ptr);
 
-			right_child->parent = ptr->parent;
-
-			if (ptr->parent == nullptr)
-				_root = right_child;
-			else if (ptr == ptr->parent->left)
-				ptr->parent->left = right_child;
-			else
-				ptr->parent->right = right_child;
+			right_child->setParent(ptr->parent());
+			replaceChild(ptr, right_child);
 
 			right_child->left = ptr;
-			ptr->parent = right_child;
+			ptr->setParent(right_child);
+			updateSize(ptr);
+			updateSize(right_child);
 		}
 
 		void rotateRight(node_pointer ptr) {
 			node_pointer left_child = ptr->left;
 			ptr->left = left_child->right;
 
-			if (ptr->left != nullptr)
-				ptr->left->parent = ptr;
+			if (ptr->left != NULL)
+				ptr->left->setParent(ptr);
 
-			left_child->parent = ptr->parent;
-
-			if (ptr->parent == nullptr)
-				_root = left_child;
-			else if (ptr == ptr->parent->left)
-				ptr->parent->left = left_child;
-			else
-				ptr->parent->right = left_child;
+			left_child->setParent(ptr->parent());
+			replaceChild(ptr, left_child);
 
 			left_child->right = ptr;
-			ptr->parent = left_child;
+			ptr->setParent(left_child);
+			updateSize(ptr);
+			updateSize(left_child);
 		}
 
 		node_pointer minValueNode(node_pointer node) {
 			node_pointer ptr = node;
-			while (ptr->left != nullptr && !ptr->isDoubleBlack())
+			while (ptr->left != NULL)
 				ptr = ptr->left;
 			return ptr;
 		}
 
 		node_pointer maxValueNode(node_pointer node) {
 			node_pointer ptr = node;
-			while (ptr->right != nullptr && !ptr->isDoubleBlack())
+			while (ptr->right != NULL)
 				ptr = ptr->right;
 			return ptr;
 		}
 
+		// In-order neighbours inside the tree; neither is called on the header.
+		node_pointer successor(node_pointer node) {
+			if (node->right)
+				return minValueNode(node->right);
+			while (node->isRight())
+				node = node->parent();
+			return node->parent();
+		}
+
+		node_pointer predecessor(node_pointer node) {
+			if (node->left)
+				return maxValueNode(node->left);
+			while (node->isLeft())
+				node = node->parent();
+			return node->parent();
+		}
+
 		size_type getBlackHeight(node_pointer node) {
 			size_type height = 0;
-			while (node != nullptr) {
+			while (node != NULL) {
 				if (getColor(node) == BLACK)
 					height++;
 				node = node->left;
@@ -262,44 +562,62 @@ namespace ft {
 
 		void fixDependencies(node_pointer node) {
 			if (node->left)
-				node->left->parent = node;
+				node->left->setParent(node);
 			if (node->right)
-				node->right->parent = node;
+				node->right->setParent(node);
 		}
-		node_pointer* selfParentPtr(node_pointer node) {
-			if (!node->parent)
-				return &_root;
+		// Points whatever links down to node (its parent, or the header) at child.
+		void replaceChild(node_pointer node, node_pointer child) {
+			if (node->isRoot())
+				_end->setParent(child);
 			else if (node->isLeft())
-				return &node->parent->left;
+				node->parent()->left = child;
 			else if (node->isRight())
-				return &node->parent->right;
-			throw std::exception();
+				node->parent()->right = child;
+			else
+				throw std::exception();
 		}
+		/*
+		 * Exchanges the positions and colors of lhs and a node rhs from its right
+		 * subtree, which may be its direct child.
+		 */
 		void swapNode(node_pointer lhs, node_pointer rhs) {
-			*selfParentPtr(lhs) = rhs;
-			*selfParentPtr(rhs) = lhs;
-			std::swap(lhs->parent, rhs->parent);
-			std::swap(lhs->left, rhs->left);
-			std::swap(lhs->right, rhs->right);
-			std::swap(lhs->color, rhs->color);
+			node_pointer parent = lhs->parent(), left = lhs->left, right = lhs->right;
+			Color color = lhs->color();
+
+			replaceChild(lhs, rhs);
+			if (rhs->parent() == lhs) {
+				lhs->setParent(rhs);
+			} else {
+				replaceChild(rhs, lhs);
+				lhs->setParent(rhs->parent());
+			}
+			lhs->left = rhs->left;
+			lhs->right = rhs->right;
+			lhs->setColor(rhs->color());
+			rhs->setParent(parent);
+			rhs->left = left == rhs ? lhs : left;
+			rhs->right = right == rhs ? lhs : right;
+			rhs->setColor(color);
+			swapSizes(lhs, rhs, order_statistics());
 			fixDependencies(lhs);
 			fixDependencies(rhs);
 		}
 		node_pointer replaceNodeWithLoneChild(node_pointer a, node_pointer b) {
-			if (b->parent != a) throw std::exception();
+			if (b->parent() != a) throw std::exception();
 			if (a->left && a->right) throw std::exception();
 			if (!a->left && !a->right) throw std::exception();
-			b->parent = a->parent;
-			*selfParentPtr(a) = b;
+			replaceChild(a, b);
+			b->setParent(a->parent());
 			return b;
 		}
 
 		void fixInsertRBTree(node_pointer ptr) {
-			node_pointer parent = nullptr;
-			node_pointer grandparent = nullptr;
-			while (ptr != _root && getColor(ptr) == RED && getColor(ptr->parent) == RED) {
-				parent = ptr->parent;
-				grandparent = parent->parent;
+			node_pointer parent = NULL;
+			node_pointer grandparent = NULL;
+			while (ptr != root() && getColor(ptr) == RED && getColor(ptr->parent()) == RED) {
+				parent = ptr->parent();
+				grandparent = parent->parent();
 				if (parent == grandparent->left) {
 					node_pointer uncle = grandparent->right;
 					if (getColor(uncle) == RED) {
@@ -311,10 +629,11 @@ namespace ft {
 						if (ptr == parent->right) {
 							rotateLeft(parent);
 							ptr = parent;
-							parent = ptr->parent;
+							parent = ptr->parent();
 						}
 						rotateRight(grandparent);
-						std::swap(parent->color, grandparent->color);
+						setColor(parent, BLACK);
+						setColor(grandparent, RED);
 						ptr = parent;
 					}
 				} else {
@@ -328,213 +647,705 @@ namespace ft {
 						if (ptr == parent->left) {
 							rotateRight(parent);
 							ptr = parent;
-							parent = ptr->parent;
+							parent = ptr->parent();
 						}
 						rotateLeft(grandparent);
-						std::swap(parent->color, grandparent->color);
+						setColor(parent, BLACK);
+						setColor(grandparent, RED);
 						ptr = parent;
 					}
 				}
 			}
-			setColor(_root, BLACK);
+			setColor(root(), BLACK);
 		}
 
-		node_pointer insertBST(node_pointer root, node_pointer ptr) {
-			if (root == nullptr || root->isDoubleBlack()) return ptr;
-			if (_comparator(ptr->data, root->data)) {
-
-				root->left = insertBST(root->left, ptr);
-				root->left->parent = root;
-
-		} else if (!_comparator(ptr->data, root->data)) {
-
-				root->right = insertBST(root->right, ptr);
-				root->right->parent = root;
-
+		/*
+		 * Links ptr below the last node it compares against; equivalent values go to
+		 * the right, after the ones already in the tree.
+		 */
+		node_pointer insertBST(node_pointer ptr) {
+			node_pointer parent = _end;
+			node_pointer current = root();
+			bool left = true;
+			while (current != NULL) {
+				parent = current;
+				left = _comparator(keyOf(ptr->data), keyOf(current->data));
+				current = left ? current->left : current->right;
 			}
-			return root;
+			return linkNode(parent, left, ptr);
 		}
 
+		/*
+		 * Restores the black height around node, a black leaf-or-single-path node
+		 * that is about to be unlinked and so counts as double black until fixed.
+		 */
 		void fixDeleteRBTree(node_pointer node) {
-			if (node->parent) {							// case 1
-				if (node->sibling() && node->sibling()->color == RED) 		// case 2
-				{
-					node->parent->color = RED;
-					node->sibling()->color = BLACK;
+			node_pointer parent;
+			node_pointer sibling;
+			while (true) {
+				if (node->isRoot())						// case 1
+					return;
+
+				parent = node->parent();
+				sibling = node->sibling();
+				if (getColor(sibling) == RED) {			// case 2
+					setColor(parent, RED);
+					setColor(sibling, BLACK);
 					if (node->isLeft())
-						rotateLeft(node->parent);
+						rotateLeft(parent);
 					else
-						rotateRight(node->parent);
-				}
-				if (node->parent->color == BLACK && node->sibling() &&		// case 3
-					node->sibling()->color == BLACK &&
-					(!node->sibling()->left || node->sibling()->left->color == BLACK) &&
-					((!node->sibling()->right || node->sibling()->right->isDoubleBlack()) || node->sibling()->right->color == BLACK))
-				{
-					node->sibling()->color = RED;
-					fixDeleteRBTree(node->parent);
-				}
-				else if (node->parent->color == RED && node->sibling() &&		// case 4
-						 node->sibling()->color == BLACK &&
-						 (!node->sibling()->left || node->sibling()->left->color == BLACK) &&
-						 ((!node->sibling()->right || node->sibling()->right->isDoubleBlack()) || node->sibling()->right->color == BLACK))
-				{
-					node->sibling()->color = RED;
-					node->parent->color = BLACK;
-				}
-				else if (node->isLeft() && node->sibling() &&				// case 5
-						 node->sibling()->color == BLACK &&
-						 node->sibling()->left && node->sibling()->left->color == RED &&
-						 ((!node->sibling()->right || node->sibling()->right->isDoubleBlack()) || node->sibling()->right->color == BLACK))
-				{
-					node->sibling()->color = RED;
-					node->sibling()->left->color = BLACK;
-					rotateRight(node->sibling());
-				}
-				else if (node->isRight() && node->sibling() &&			// still case 5
-						 node->sibling()->color == BLACK &&
-						 node->sibling()->right && !node->sibling()->right->isDoubleBlack() && node->sibling()->right->color == RED &&
-						 (!node->sibling()->left || node->sibling()->left->color == BLACK))
-				{
-					node->sibling()->color = RED;
-					node->sibling()->right->color = BLACK;
-					rotateLeft(node->sibling());
+						rotateRight(parent);
+					sibling = node->sibling();
 				}
-				if (node->sibling())
-					node->sibling()->color = node->parent->color; // case 6
-				node->parent->color = BLACK;
-
-				if (node->sibling()) {
-					if (node->isLeft()) {
-						if (node->sibling()->right && !node->sibling()->right->isDoubleBlack())
-							node->sibling()->right->color = BLACK;
-						rotateLeft(node->parent);
-					} else {
-						if (node->sibling()->right && !node->sibling()->right->isDoubleBlack())
-							node->sibling()->left->color = BLACK;
-						rotateRight(node->parent);
-					}
+
+				if (getColor(sibling->left) == RED || getColor(sibling->right) == RED)
+					break;
+
+				setColor(sibling, RED);
+				if (getColor(parent) == RED) {			// case 4
+					setColor(parent, BLACK);
+					return;
 				}
+				node = parent;							// case 3
+			}
+
+			if (node->isLeft() && getColor(sibling->right) == BLACK) {	// case 5
+				setColor(sibling->left, BLACK);
+				setColor(sibling, RED);
+				rotateRight(sibling);
+				sibling = parent->right;
+			} else if (node->isRight() && getColor(sibling->left) == BLACK) {
+				setColor(sibling->right, BLACK);
+				setColor(sibling, RED);
+				rotateLeft(sibling);
+				sibling = parent->left;
+			}
+
+			setColor(sibling, getColor(parent));		// case 6
+			setColor(parent, BLACK);
+			if (node->isLeft()) {
+				setColor(sibling->right, BLACK);
+				rotateLeft(parent);
+			} else {
+				setColor(sibling->left, BLACK);
+				rotateRight(parent);
 			}
 		}
 
 		void deleteBST(node_pointer node) {
 
-			if (!node->parent && !node->left && (!node->right || node->right->isDoubleBlack()))
-				_root = NULL;
+			if (node->left && node->right)
+				swapNode(node, minValueNode(node->right));
 
-			else if (!node->left && (!node->right || node->right->isDoubleBlack())) {
+			node_pointer child = node->left ? node->left : node->right;
+			if (child) {
+				replaceNodeWithLoneChild(node, child);
+				setColor(child, BLACK);
+				updatePathSizes(child->parent());
+				return;
+			}
+
+			if (node->isBlack())
+				fixDeleteRBTree(node);
+			replaceChild(node, NULL);
+			updatePathSizes(node->parent());
+		}
+
+		/*
+		 * Frees a subtree without recursion: left children are rotated up until the
+		 * current node has none, then it is freed and the walk moves to its right.
+		 */
+		void covid19(node_pointer node) {
+			while (node) {
+				if (node->left) {
+					node_pointer left = node->left;
+					node->left = left->right;
+					left->right = node;
+					node = left;
+				} else {
+					node_pointer right = node->right;
+					destroyNode(node);
+					node = right;
+				}
+			}
+		}
 
-				if (node->isLeft())
-					node->parent->left = NULL;
+		// Empties the tree but leaves the nodes' memory in the pool for an immediate refill.
+		void destroyAll() {
+			covid19(root());
+			_end->setParent(NULL);
+			_end->left = _end;
+			_end->right = _end;
+			rethread();
+		}
+
+		void updateExtremes(node_pointer node) {
+			if (node->parent() == _end) {
+				_end->left = node;
+				_end->right = node;
+			} else if (node->isLeft() && node->parent() == _end->left) {
+				_end->left = node;
+			} else if (node->isRight() && node->parent() == _end->right) {
+				_end->right = node;
+			}
+		}
+
+		/*
+		 * One descent from the root: returns the node holding an equivalent value, or
+		 * NULL after leaving in parent/left the slot a new node for data would take.
+		 */
+		node_pointer findSlot(const value_type &data, node_pointer &parent, bool &left) {
+			node_pointer current = root();
+			parent = _end;
+			left = true;
+			while (current != NULL) {
+				parent = current;
+				if (_comparator(keyOf(data), keyOf(current->data)))
+					left = true;
+				else if (_comparator(keyOf(current->data), keyOf(data)))
+					left = false;
 				else
-					node->parent->right = NULL;
+					return current;
+				current = left ? current->left : current->right;
+			}
+			return NULL;
+		}
 
-			} else if (node->left && node->right && !node->right->isDoubleBlack()) {
+		// First node in the subtree at node whose key is not less than key, else result.
+		template<class K>
+		node_pointer lowerBound(node_pointer node, const K &key, node_pointer result) {
+			while (node != NULL) {
+				if (_comparator(keyOf(node->data), key)) {
+					node = node->right;
+				} else {
+					result = node;
+					node = node->left;
+				}
+			}
+			return result;
+		}
 
-				node_pointer min = minValueNode(node->right);
-				swapNode(node, min);
-				deleteBST(node);
+		// First node in the subtree at node whose key is greater than key, else result.
+		template<class K>
+		node_pointer upperBound(node_pointer node, const K &key, node_pointer result) {
+			while (node != NULL) {
+				if (_comparator(key, keyOf(node->data))) {
+					result = node;
+					node = node->left;
+				} else {
+					node = node->right;
+				}
+			}
+			return result;
+		}
 
-			} else if (!node->left) {
+		/*
+		 * findSlot for a value expected next to hint. One that belongs right before or
+		 * right after hint gets its slot from one or two comparisons with the
+		 * neighbours, anything else falls back to the descent from the root.
+		 */
+		node_pointer findHintSlot(node_pointer hint, const value_type &data, node_pointer &parent, bool &left) {
+			if (hint == _end) {
+				if (root() && _comparator(keyOf(_end->right->data), keyOf(data))) {
+					parent = _end->right;
+					left = false;
+					return NULL;
+				}
+				return findSlot(data, parent, left);
+			}
 
-				node = replaceNodeWithLoneChild(node, node->right);
-				fixDeleteRBTree(node);
+			if (_comparator(keyOf(data), keyOf(hint->data))) {
+				node_pointer prev = hint == _end->left ? NULL : predecessor(hint);
+				if (prev && !_comparator(keyOf(prev->data), keyOf(data)))
+					return findSlot(data, parent, left);
+				left = !prev || prev->right != NULL;
+				parent = left ? hint : prev;
+				return NULL;
+			}
 
-			} else if (!node->right || node->right->isDoubleBlack()) {
-				node = replaceNodeWithLoneChild(node, node->left);
-				fixDeleteRBTree(node);
+			if (_comparator(keyOf(hint->data), keyOf(data))) {
+				node_pointer next = hint == _end->right ? NULL : successor(hint);
+				if (next && !_comparator(keyOf(data), keyOf(next->data)))
+					return findSlot(data, parent, left);
+				left = hint->right != NULL;
+				parent = left ? next : hint;
+				return NULL;
 			}
 
+			return hint;
 		}
 
-		void covid19(node_pointer node) {
-			if (!node || node->isDoubleBlack()) return;
+		node_pointer linkNode(node_pointer parent, bool left, node_pointer node) {
+			node->setParent(parent);
+			if (parent == _end)
+				_end->setParent(node);
+			else if (left)
+				parent->left = node;
+			else
+				parent->right = node;
+			updatePathSizes(parent);
+			updateExtremes(node);
+			threadNode(parent, left, node);
+			fixInsertRBTree(node);
 
-			covid19(node->left);
-			covid19(node->right);
+			return node;
+		}
 
-			_allocator.destroy(node);
-			_allocator.deallocate(node, 1);
+		/*
+		 * Links the next n nodes of a right-linked chain into a balanced subtree and
+		 * returns its root. Splitting at the middle keeps every level above the last
+		 * one full, so painting only the nodes at red_depth red gives every path the
+		 * same black height.
+		 */
+		node_pointer buildBalanced(node_pointer &chain, size_type n, size_type depth, size_type red_depth) {
+			if (n == 0)
+				return NULL;
+			size_type left_size = (n - 1) / 2;
+			node_pointer left = buildBalanced(chain, left_size, depth + 1, red_depth);
+			node_pointer node = chain;
+			chain = chain->right;
+
+			node->left = left;
+			if (left)
+				left->setParent(node);
+			node->right = buildBalanced(chain, n - 1 - left_size, depth + 1, red_depth);
+			if (node->right)
+				node->right->setParent(node);
+			node->setColor(depth == red_depth && depth > 0 ? RED : BLACK);
+			updateSize(node);
+			return node;
 		}
 
-		void fixSEPoints() {
+		// Turns a right-linked chain of n sorted nodes into the whole tree.
+		void linkSortedChain(node_pointer head, node_pointer tail, size_type n) {
+			size_type red_depth = 0;
+			while ((n >> (red_depth + 1)) != 0)
+				red_depth++;
+			node_pointer root = buildBalanced(head, n, 0, red_depth);
+			root->setParent(_end);
+			_end->setParent(root);
+			_end->left = minValueNode(root);
+			_end->right = tail;
+			rethread();
+		}
 
-			if (!_root) {
-				_start = _root;
-				_end = _root;
-				return;
+		/*
+		 * Nodes are built in place: allocator construct() takes a finished node_type in
+		 * C++98, which would copy every value twice.
+		 */
+		node_pointer createNode(const value_type &data) {
+			node_pointer node = _pool.allocate();
+			try {
+				::new (static_cast<void *>(node)) node_type(data);
+			} catch (...) {
+				_pool.deallocate(node);
+				throw;
 			}
+			return node;
+		}
 
-			node_pointer current = _root;
-			while (current->left != nullptr)
-				current = current->left;
-			_start = current;
+#if __cplusplus >= 201103L
+		node_pointer createNode(value_type &&data) {
+			node_pointer node = _pool.allocate();
+			try {
+				_allocator.construct(node, std::move(data));
+			} catch (...) {
+				_pool.deallocate(node);
+				throw;
+			}
+			return node;
+		}
+#endif
 
-			if (!_end)
-				_allocator.construct(_end, node_type(value_type(), DOUBLE_BLACK));
+		// A node with the value, color and subtree size of src and no children yet.
+		node_pointer cloneNode(node_pointer src, node_pointer parent) {
+			node_pointer node = _pool.allocate();
+			try {
+				::new (static_cast<void *>(node)) node_type(*src, src->data);
+			} catch (...) {
+				_pool.deallocate(node);
+				throw;
+			}
+			node->setParent(parent);
+			node->left = NULL;
+			node->right = NULL;
+			return node;
+		}
 
-			current = _root;
-			while (current->right != nullptr && !current->right->isDoubleBlack())
-				current = current->right;
-			current->right = _end;
-			_end->parent = current;
+		/*
+		 * Copies the subtree at src node for node, shape and colors included, so the copy
+		 * is already balanced and never compares or rotates. Only right subtrees are
+		 * copied recursively; the left spine is walked in a loop.
+		 */
+		node_pointer copySubtree(node_pointer src, node_pointer parent) {
+			node_pointer top = cloneNode(src, parent);
+			try {
+				if (src->right)
+					top->right = copySubtree(src->right, top);
+				parent = top;
+				for (src = src->left; src != NULL; src = src->left) {
+					node_pointer node = cloneNode(src, parent);
+					parent->left = node;
+					if (src->right)
+						node->right = copySubtree(src->right, node);
+					parent = node;
+				}
+			} catch (...) {
+				covid19(top);
+				throw;
+			}
+			return top;
+		}
+
+		void destroyNode(node_pointer node) {
+			_allocator.destroy(node);
+			_pool.deallocate(node);
 		}
 
 	public:
-		RBTree(const allocator_type &alloc = allocator_type())
-				: _root(nullptr), _allocator(alloc), _end(nullptr), _start(nullptr) {
+		RBTree(const allocator_type &alloc = allocator_type(), const Compare &comp = Compare())
+				: _allocator(alloc), _pool(alloc), _comparator(comp), _end(NULL) {
+			_end = _allocator.allocate(1);
+			::new (static_cast<void *>(_end)) node_type(value_type(), RED);
+			_end->left = _end;
+			_end->right = _end;
+			rethread();
+		}
+
+		RBTree(const RBTree &other)
+				: _allocator(other._allocator), _pool(other._allocator), _comparator(other._comparator), _end(NULL) {
 			_end = _allocator.allocate(1);
-			_allocator.construct(_end, node_type(value_type(), DOUBLE_BLACK));
+			::new (static_cast<void *>(_end)) node_type(value_type(), RED);
+			_end->left = _end;
+			_end->right = _end;
+			assign(other);
+		}
+
+		RBTree &operator=(const RBTree &other) {
+			assign(other);
+			return *this;
+		}
+
+		// The ordering every lookup and insertion goes through.
+		const Compare &key_comp() const {
+			return _comparator;
 		}
 
 		~RBTree() {
+			clear();
 			_allocator.destroy(_end);
 			_allocator.deallocate(_end, 1);
 		}
 
 		node_pointer insert(const value_type &data) {
-			node_pointer node = _allocator.allocate(1);
-			_allocator.construct(node, RBNode<value_type>(data));
-			_root = insertBST(_root, node);
-			fixInsertRBTree(node);
-			fixSEPoints();
+			node_pointer node = createNode(data);
+			return insertBST(node);
+		}
 
-			return node;
+#if __cplusplus >= 201103L
+		node_pointer insert(value_type &&data) {
+			node_pointer node = createNode(std::move(data));
+			return insertBST(node);
+		}
+#endif
+
+		ft::pair<node_pointer, bool> insert_unique(const value_type &data) {
+			node_pointer parent;
+			bool left;
+			node_pointer found = findSlot(data, parent, left);
+			if (found)
+				return ft::make_pair(found, false);
+
+			node_pointer node = createNode(data);
+			return ft::make_pair(linkNode(parent, left, node), true);
+		}
+
+#if __cplusplus >= 201103L
+		ft::pair<node_pointer, bool> insert_unique(value_type &&data) {
+			node_pointer parent;
+			bool left;
+			node_pointer found = findSlot(data, parent, left);
+			if (found)
+				return ft::make_pair(found, false);
+
+			node_pointer node = createNode(std::move(data));
+			return ft::make_pair(linkNode(parent, left, node), true);
+		}
+#endif
+
+		/*
+		 * insert_unique with a hint: amortized O(1) when data goes right before or
+		 * right after hint, as with keys arriving in order and end() as the hint.
+		 */
+		ft::pair<node_pointer, bool> insert_unique(node_pointer hint, const value_type &data) {
+			node_pointer parent;
+			bool left;
+			node_pointer found = findHintSlot(hint, data, parent, left);
+			if (found)
+				return ft::make_pair(found, false);
+
+			node_pointer node = createNode(data);
+			return ft::make_pair(linkNode(parent, left, node), true);
+		}
+
+#if __cplusplus >= 201103L
+		ft::pair<node_pointer, bool> insert_unique(node_pointer hint, value_type &&data) {
+			node_pointer parent;
+			bool left;
+			node_pointer found = findHintSlot(hint, data, parent, left);
+			if (found)
+				return ft::make_pair(found, false);
+
+			node_pointer node = createNode(std::move(data));
+			return ft::make_pair(linkNode(parent, left, node), true);
+		}
+#endif
+
+		/*
+		 * Replaces the contents and the ordering with a copy of other's in O(n). The old
+		 * nodes go back to the pool first, so the copy is built in their memory before
+		 * any new chunk is requested.
+		 */
+		void assign(const RBTree &other) {
+			if (this == &other)
+				return;
+			destroyAll();
+			_comparator = other._comparator;
+			node_pointer src = other._end->parent();
+			if (src == NULL) {
+				_pool.release();
+				return;
+			}
+			node_pointer root = copySubtree(src, _end);
+			_end->setParent(root);
+			_end->left = minValueNode(root);
+			_end->right = maxValueNode(root);
+			rethread();
+		}
+
+		/*
+		 * Replaces the contents with the n values starting at first, which must be
+		 * strictly increasing. The nodes are created in order from a single pool chunk
+		 * and then linked into a balanced tree without a single comparison or rotation.
+		 */
+		template<class U>
+		void assign_sorted(U first, size_type n) {
+			clear();
+			if (n == 0)
+				return;
+			_pool.reserve(n);
+
+			node_pointer head = NULL;
+			node_pointer tail = NULL;
+			try {
+				for (size_type i = 0; i < n; ++i, ++first) {
+					node_pointer node = createNode(*first);
+					if (tail)
+						tail->right = node;
+					else
+						head = node;
+					tail = node;
+				}
+			} catch (...) {
+				covid19(head);
+				throw;
+			}
+			linkSortedChain(head, tail, n);
+		}
+
+		// Same as above for a whole range; returns the number of values taken.
+		template<class U>
+		size_type assign_sorted(U first, U last, ft::forward_iterator_tag) {
+			size_type n = ft::distance(first, last);
+			assign_sorted(first, n);
+			return n;
+		}
+
+		// Input iterators can only be read once, so the nodes are counted as they are chained.
+		template<class U>
+		size_type assign_sorted(U first, U last, ft::input_iterator_tag) {
+			clear();
+			node_pointer head = NULL;
+			node_pointer tail = NULL;
+			size_type n = 0;
+			try {
+				for (; first != last; ++first, ++n) {
+					node_pointer node = createNode(*first);
+					if (tail)
+						tail->right = node;
+					else
+						head = node;
+					tail = node;
+				}
+			} catch (...) {
+				covid19(head);
+				throw;
+			}
+			if (n)
+				linkSortedChain(head, tail, n);
+			return n;
 		}
 
 		void remove(node_pointer node) {
-			if (!node) return;
+			if (!node || node == _end) return;
+			if (node == _end->left)
+				_end->left = node->right ? minValueNode(node->right) : node->parent();
+			if (node == _end->right)
+				_end->right = node->left ? maxValueNode(node->left) : node->parent();
+			unthreadNode(node);
 			deleteBST(node);
-			fixSEPoints();
+			destroyNode(node);
+			if (!root())
+				_pool.release();
 		}
 
-		node_pointer find(const value_type &data) {
-			node_pointer current = _root;
-			while (current != nullptr && !current->isDoubleBlack()) {
-				if (!_comparator(data, current->data) && !_comparator(current->data, data))
-					return current;
-				else if (_comparator(data, current->data))
-					current = current->left;
-				else
-					current = current->right;
+		// One comparison per level down to the lower bound, one more to confirm it.
+		template<class K>
+		node_pointer find(const K &key) {
+			node_pointer node = lowerBound(root(), key, _end);
+			if (node == _end || _comparator(key, keyOf(node->data)))
+				return _end;
+			return node;
+		}
+
+		/*
+		 * find() for every key in [first, last), writing one Iterator built from the
+		 * node found (end() when absent) to out per key. Keys are looked up find_group at a time in lockstep: each
+		 * round moves every lookup of the group down one level and prefetches the
+		 * node it lands on, so a group waits for its cache misses together instead of
+		 * one after the other.
+		 */
+		static const size_type find_group = 16;
+
+		template<class Iterator, class ForwardIt, class OutputIt>
+		OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) {
+			ForwardIt keys[find_group];
+			node_pointer nodes[find_group];
+			node_pointer bounds[find_group];
+
+			while (first != last) {
+				size_type n = 0;
+				for (; n < find_group && first != last; ++n, ++first) {
+					keys[n] = first;
+					nodes[n] = root();
+					bounds[n] = _end;
+				}
+
+				for (bool active = true; active;) {
+					active = false;
+					for (size_type i = 0; i < n; ++i) {
+						node_pointer node = nodes[i];
+						if (node == NULL)
+							continue;
+						if (_comparator(keyOf(node->data), *keys[i])) {
+							node = node->right;
+						} else {
+							bounds[i] = node;
+							node = node->left;
+						}
+						nodes[i] = node;
+						if (node != NULL) {
+							__builtin_prefetch(node);
+							active = true;
+						}
+					}
+				}
+
+				for (size_type i = 0; i < n; ++i, ++out) {
+					node_pointer node = bounds[i];
+					*out = Iterator(node == _end || _comparator(*keys[i], keyOf(node->data)) ? _end : node);
+				}
+			}
+			return out;
+		}
+
+		template<class K>
+		node_pointer lower_bound(const K &key) {
+			return lowerBound(root(), key, _end);
+		}
+
+		template<class K>
+		node_pointer upper_bound(const K &key) {
+			return upperBound(root(), key, _end);
+		}
+
+		/*
+		 * lower_bound and upper_bound in one descent: the paths are shared down to
+		 * the first equivalent node, then each bound only searches one side of it.
+		 */
+		template<class K>
+		ft::pair<node_pointer, node_pointer> equal_range(const K &key) {
+			node_pointer node = root();
+			node_pointer upper = _end;
+			while (node != NULL) {
+				if (_comparator(keyOf(node->data), key)) {
+					node = node->right;
+				} else if (_comparator(key, keyOf(node->data))) {
+					upper = node;
+					node = node->left;
+				} else {
+					return ft::make_pair(lowerBound(node->left, key, node), upperBound(node->right, key, upper));
+				}
+			}
+			return ft::make_pair(upper, upper);
+		}
+
+		// O(log n) plus the number of matches, which is at most one in map and set.
+		template<class K>
+		size_type count(const K &key) {
+			ft::pair<node_pointer, node_pointer> range = equal_range(key);
+			size_type n = 0;
+			for (node_pointer node = range.first; node != range.second; node = successor(node))
+				n++;
+			return n;
+		}
+
+		// The k-th smallest node (counting from 0), or end() past the last one.
+		node_pointer select(size_type k) {
+			node_pointer node = root();
+			while (node != NULL) {
+				size_type left = subtreeSize(node->left);
+				if (k == left)
+					return node;
+				if (k < left) {
+					node = node->left;
+				} else {
+					k -= left + 1;
+					node = node->right;
+				}
 			}
 			return _end;
 		}
 
+		// Number of values whose key compares less than key.
+		template<class K>
+		size_type rank(const K &key) {
+			size_type count = 0;
+			node_pointer node = root();
+			while (node != NULL) {
+				if (_comparator(keyOf(node->data), key)) {
+					count += subtreeSize(node->left) + 1;
+					node = node->right;
+				} else {
+					node = node->left;
+				}
+			}
+			return count;
+		}
+
+		// No node is live afterwards, so the pool hands all of its chunks back.
 		void clear() {
-			covid19(_root);
-			_start = nullptr;
-			_end = nullptr;
+			destroyAll();
+			_pool.release();
 		}
 
 		size_type max_size() { return _allocator.max_size(); }
 
 		node_pointer end() { return _end; }
 
-		node_pointer begin() { return _start; }
+		node_pointer begin() { return _end->left; }
 
-		node_pointer root() { return _root; }
+		node_pointer root() { return _end->parent(); }
 
 # define NORMAL "\033[0;37m"
 # define BOLD_RED "\033[1;31m"
@@ -543,14 +1354,15 @@ namespace ft {
 			(void) s;
 			//return;
 			std::cout << NORMAL << "===============================" << std::endl;
-			_print_tree(_root);
-			std::cout << NORMAL << "END NODE AFTER: " << _end->parent->data << std::endl;
+			_print_tree(root());
+			if (root())
+				std::cout << NORMAL << "END NODE AFTER: " << _end->right->data << std::endl;
 			std::cout << NORMAL << "===============================" << std::endl;
 		}
 
 		void _print_tree(node_pointer n, size_t l = 0) {
 
-			if (!n || n->isDoubleBlack()) {
+			if (!n) {
 				std::cout << std::endl;
 				return;
 			}
@@ -558,8 +1370,8 @@ namespace ft {
 			_print_tree(n->right, l + 1);
 			std::string coll = n->isRed() ? BOLD_RED : NORMAL;
 			std::cout << coll << std::string(l * 4, ' ');
-			if (n->parent) {
-				std::cout << "(" << n->parent->data << ")";
+			if (!n->isRoot()) {
+				std::cout << "(" << n->parent()->data << ")";
 				if (n->isLeft())
 					std::cout << "\\";
 				else
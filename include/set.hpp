@@ -13,7 +13,8 @@ namespace ft {
 	template<
 			class Key,
 			class Compare = ft::less<Key>,
-			class Allocator = std::allocator<Key>
+			class Allocator = std::allocator<Key>,
+			class Options = ft::rbtree_options<>
 	> class set {
 	public:
 		typedef Key														key_type;
@@ -27,19 +28,18 @@ namespace ft {
 		typedef const value_type&										const_reference;
 		typedef typename allocator_type::pointer						pointer;
 		typedef typename allocator_type::const_pointer					const_pointer;
-		typedef rbtree_iterator<const value_type, value_compare>		iterator;
-		typedef rbtree_iterator<const value_type, value_compare>		const_iterator;
+		typedef RBTree<value_type, value_compare, Allocator, Options>	tree_type;
+		typedef typename tree_type::node_type							node_type;
+		typedef node_type*												node_pointer;
+		typedef typename Allocator::template rebind<tree_type>::other	tree_allocator_type;
+		typedef rbtree_iterator<const value_type, false, node_type>	iterator;
+		typedef rbtree_iterator<const value_type, false, node_type>	const_iterator;
 		typedef ft::reverse_iterator<iterator>							reverse_iterator;
 		typedef ft::reverse_iterator<const_iterator>					const_reverse_iterator;
 
-		typedef RBTree<value_type, value_compare>						tree_type;
-		typedef RBNode<value_type>										node_type;
-		typedef node_type*												node_pointer;
-
 	protected:
 		tree_type*					_tree;
-		std::allocator<tree_type>	_tree_allocator;
-		key_compare					_comparator;
+		tree_allocator_type			_tree_allocator;
 		allocator_type				_allocator;
 		size_type					_size;
 
@@ -49,45 +49,66 @@ namespace ft {
 
 		set() : _allocator(Allocator()), _size(0) {
 			_tree = _tree_allocator.allocate(1);
-			_tree_allocator.construct(_tree);
+			new (_tree) tree_type(_allocator);
 		}
 
-		explicit set(const Compare &comp, const Allocator &alloc = Allocator()) : _comparator(comp), _allocator(alloc),
-																				  _size(0) {
+		explicit set(const Compare &comp, const Allocator &alloc = Allocator()) : _allocator(alloc), _size(0) {
 			_tree = _tree_allocator.allocate(1);
-			_tree_allocator.construct(_tree);
+			new (_tree) tree_type(_allocator, comp);
 		}
 
 		template<class U>
-		set(U first, U last, const Compare &comp = Compare(), const Allocator &alloc = Allocator()) : _comparator(comp),
-				_allocator(alloc),
-				_size(0) {
+		set(U first, U last, const Compare &comp = Compare(), const Allocator &alloc = Allocator())
+				: _allocator(alloc), _size(0) {
 			_tree = _tree_allocator.allocate(1);
-			_tree_allocator.construct(_tree);
-			while (first != last)
-				insert(*first++);
+			new (_tree) tree_type(_allocator, comp);
+			insert(first, last);
 		}
 
-		set(const set &other) : _comparator(other.key_comp()), _allocator(other.get_allocator()), _size(0) {
+		// Builds the tree in O(n) from a range that is already sorted and unique.
+		template<class U>
+		set(from_sorted_unique_t, U first, U last, const Compare &comp = Compare(),
+			const Allocator &alloc = Allocator()) : _allocator(alloc), _size(0) {
 			_tree = _tree_allocator.allocate(1);
-			_tree_allocator.construct(_tree);
-			const_iterator it = other.begin();
-			while (it != other.end())
-				insert(*it++);
+			new (_tree) tree_type(_allocator, comp);
+			_size = _tree->assign_sorted(first, last, ft::iterator_category(first));
 		}
 
-		~set() {
-			clear();
+		set(const set &other) : _allocator(other.get_allocator()), _size(other._size) {
+			_tree = _tree_allocator.allocate(1);
+			new (_tree) tree_type(*other._tree);
 		}
 
-		set& operator=(const set& other) {
+#if __cplusplus >= 201103L
+		set(set &&other) : _allocator(other._allocator), _size(other._size) {
+			_tree = _tree_allocator.allocate(1);
+			new (_tree) tree_type(_allocator, other.key_comp());
+			ft::swap(_tree, other._tree);
+			other._size = 0;
+		}
+
+		set &operator=(set &&other) {
+			if (this != &other) {
+				clear();
+				ft::swap(_tree, other._tree);
+				ft::swap(_size, other._size);
+			}
+			return *this;
+		}
+#endif
+
+		~set() {
 			_tree_allocator.destroy(_tree);
 			_tree_allocator.deallocate(_tree, 1);
+		}
 
-			_tree = _tree_allocator.allocate(1);
-			_tree_allocator.construct(_tree);
-			_size = 0;
-			insert(other.begin(), other.end());
+		set& operator=(const set& other) {
+			if (this != &other) {
+				// assign empties the tree first, so a throwing copy leaves it empty.
+				_size = 0;
+				_tree->assign(*other._tree);
+				_size = other._size;
+			}
 			return *this;
 		}
 
@@ -121,133 +142,99 @@ namespace ft {
 		size_type max_size() const { return _tree->max_size(); }
 
 		ft::pair<iterator, bool> insert(const value_type &value) {
-			node_pointer node = _tree->find(value);
-			if (node != end().base())
-				return ft::make_pair(iterator(node), false);
-			node = _tree->insert(value);
-			_size++;
-			return ft::make_pair(iterator(node), true);
+			ft::pair<node_pointer, bool> res = _tree->insert_unique(value);
+			if (res.second)
+				_size++;
+			return ft::make_pair(iterator(res.first), res.second);
 		}
 
+#if __cplusplus >= 201103L
+		ft::pair<iterator, bool> insert(value_type &&value) {
+			ft::pair<node_pointer, bool> res = _tree->insert_unique(std::move(value));
+			if (res.second)
+				_size++;
+			return ft::make_pair(iterator(res.first), res.second);
+		}
+
+		template<class... Args>
+		ft::pair<iterator, bool> emplace(Args &&... args) {
+			return insert(value_type(std::forward<Args>(args)...));
+		}
+#endif
+
 		iterator insert(iterator hint, const value_type &value) {
-			(void) hint;
-			return insert(value).first;
+			ft::pair<node_pointer, bool> res = _tree->insert_unique(hint.base(), value);
+			if (res.second)
+				_size++;
+			return iterator(res.first);
 		}
 
 		template<class U>
 		void insert(U first, U last, typename enable_if<!ft::is_integral<U>::value, U>::type * = 0) {
-			while (first != last)
-				insert(*first++);
+			this->insert_range(first, last, ft::iterator_category(first));
 		}
 
 		ft::pair<iterator, iterator> equal_range(const Key &key) {
-			return ft::make_pair(iterator(lower_bound(key)), iterator(upper_bound(key)));
+			ft::pair<node_pointer, node_pointer> range = _tree->equal_range(key);
+			return ft::make_pair(iterator(range.first), iterator(range.second));
 		}
 
 		ft::pair<const_iterator, const_iterator> equal_range(const Key &key) const {
-			return ft::make_pair(const_iterator(lower_bound(key)), const_iterator(upper_bound(key)));
+			ft::pair<node_pointer, node_pointer> range = _tree->equal_range(key);
+			return ft::make_pair(const_iterator(range.first), const_iterator(range.second));
+		}
+
+		/*
+		 * The template lookups below only exist for a transparent Compare, such as
+		 * ft::less<void>: they pass key straight to the comparator, so it never has to
+		 * be converted to key_type.
+		 */
+		template<class K>
+		ft::pair<iterator, iterator> equal_range(const K &key, typename enable_if<__is_transparent<Compare>::value, K>::type * = 0) {
+			ft::pair<node_pointer, node_pointer> range = _tree->equal_range(key);
+			return ft::make_pair(iterator(range.first), iterator(range.second));
+		}
+
+		template<class K>
+		ft::pair<const_iterator, const_iterator> equal_range(const K &key, typename enable_if<__is_transparent<Compare>::value, K>::type * = 0) const {
+			ft::pair<node_pointer, node_pointer> range = _tree->equal_range(key);
+			return ft::make_pair(const_iterator(range.first), const_iterator(range.second));
 		}
 
 		iterator lower_bound(const Key &key) {
-			node_type *n;
-			node_type *res;
-			res = end().base();
-			if (!_size)
-				return iterator(res);
-			n = _tree->root();
-			while (1) {
-				if ((*n).data == key) {
-					res = n;
-					break;
-				} else if (!_comparator((*n).data, key)) {
-					res = n;
-					if (!n->left)
-						break;
-					n = n->left;
-				} else if (_comparator((*n).data, key)) {
-					if (!n->right)
-						break;
-					n = n->right;
-				}
-			}
-			return iterator(res);
+			return iterator(_tree->lower_bound(key));
 		}
 
 		const_iterator lower_bound(const Key &key) const {
-			node_type *n;
-			const node_type *res;
-			res = end().base();
-			if (!_size)
-				return const_iterator(res);
-			n = _tree->root();
-			while (1) {
-				if ((*n).data == key) {
-					res = n;
-					break;
-				} else if (!_comparator((*n).data, key)) {
-					res = n;
-					if (!n->left)
-						break;
-					n = n->left;
-				} else if (_comparator((*n).data, key)) {
-					if (!n->right)
-						break;
-					n = n->right;
-				}
-			}
-			return const_iterator(res);
+			return const_iterator(_tree->lower_bound(key));
 		}
 
 		iterator upper_bound(const Key &key) {
-			node_type *n;
-			node_type *res;
-			res = end().base();
-			if (!_size)
-				return iterator(res);
-			n = _tree->root();
-			while (1) {
-				if ((*n).data == key) {
-					if (!n->right)
-						break;
-					n = n->right;
-				} else if (!_comparator((*n).data, key)) {
-					res = n;
-					if (!n->left)
-						break;
-					n = n->left;
-				} else if (_comparator((*n).data, key)) {
-					if (!n->right)
-						break;
-					n = n->right;
-				}
-			}
-			return iterator(res);
+			return iterator(_tree->upper_bound(key));
 		}
 
 		const_iterator upper_bound(const Key &key) const {
-			node_type *n;
-			const node_type *res;
-			res = end().base();
-			if (!_size)
-				return const_iterator(res);
-			n = _tree->root();
-			while (1) {
-				if ((*n).data == key) {
-					if (!n->right)
-						break;
-					n = n->right;
-				} else if (!_comparator((*n).data, key)) {
-					res = n;
-					if (!n->left)
-						break;
-					n = n->left;
-				} else if (_comparator((*n).data, key)) {
-					if (!n->right)
-						break;
-					n = n->right;
-				}
-			}
-			return const_iterator(res);
+			return const_iterator(_tree->upper_bound(key));
+		}
+
+		template<class K>
+		iterator lower_bound(const K &key, typename enable_if<__is_transparent<Compare>::value, K>::type * = 0) {
+			return iterator(_tree->lower_bound(key));
+		}
+
+		template<class K>
+		const_iterator lower_bound(const K &key, typename enable_if<__is_transparent<Compare>::value, K>::type * = 0) const {
+			return const_iterator(_tree->lower_bound(key));
+		}
+
+		template<class K>
+		iterator upper_bound(const K &key, typename enable_if<__is_transparent<Compare>::value, K>::type * = 0) {
+			return iterator(_tree->upper_bound(key));
+		}
+
+		template<class K>
+		const_iterator upper_bound(const K &key, typename enable_if<__is_transparent<Compare>::value, K>::type * = 0) const {
+			return const_iterator(_tree->upper_bound(key));
 		}
 
 		iterator find(const Key &key) {
@@ -258,6 +245,44 @@ namespace ft {
 			return const_iterator(_tree->find(key));
 		}
 
+		template<class K>
+		iterator find(const K &key, typename enable_if<__is_transparent<Compare>::value, K>::type * = 0) {
+			return iterator(_tree->find(key));
+		}
+
+		template<class K>
+		const_iterator find(const K &key, typename enable_if<__is_transparent<Compare>::value, K>::type * = 0) const {
+			return const_iterator(_tree->find(key));
+		}
+
+		/*
+		 * Looks up every key in [first, last) and writes an iterator to out for each,
+		 * end() for the missing ones. Lookups run interleaved in small groups, which
+		 * is much faster than a find() loop once the tree no longer fits in cache.
+		 */
+		template<class ForwardIt, class OutputIt>
+		OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) {
+			return _tree->template find_many<iterator>(first, last, out);
+		}
+
+		template<class ForwardIt, class OutputIt>
+		OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const {
+			return _tree->template find_many<const_iterator>(first, last, out);
+		}
+
+		// Order statistics, only available with rbtree_options<C, true>.
+		iterator nth(size_type k) {
+			return iterator(_tree->select(k));
+		}
+
+		const_iterator nth(size_type k) const {
+			return const_iterator(_tree->select(k));
+		}
+
+		size_type rank(const Key &key) const {
+			return _tree->rank(key);
+		}
+
 		void erase(iterator pos) {
 			_tree->remove(pos.base());
 			_size--;
@@ -273,6 +298,17 @@ namespace ft {
 			return 0;
 		}
 
+		template<class K>
+		size_type erase(const K &k, typename enable_if<__is_transparent<Compare>::value, K>::type * = 0) {
+			iterator found = find(k);
+			if (found != end()) {
+				_tree->remove(found.base());
+				_size--;
+				return 1;
+			}
+			return 0;
+		}
+
 		void erase(iterator first, iterator last) {
 			ft::vector<Key> keys;
 			for (iterator it = first; it != last; it++)
@@ -282,52 +318,97 @@ namespace ft {
 		}
 
 		size_type count(const Key &key) const {
-			size_type s = 0;
-			for (const_iterator it = begin(); it != end(); it++)
-				if (*it == key)
-					s++;
-			return s;
+			return _tree->count(key);
 		}
 
+		template<class K>
+		size_type count(const K &key, typename enable_if<__is_transparent<Compare>::value, K>::type * = 0) const {
+			return _tree->count(key);
+		}
+
+		// Trees stay where they are, only the handles change hands.
 		void swap(set& other) {
-			set temp = *this;
-			*this = other;
-			other = temp;
+			ft::swap(_tree, other._tree);
+			ft::swap(_tree_allocator, other._tree_allocator);
+			ft::swap(_allocator, other._allocator);
+			ft::swap(_size, other._size);
 		}
 
-		key_compare key_comp() const { return Compare(); }
-		value_compare value_comp() const { return value_compare(); }
+		key_compare key_comp() const { return _tree->key_comp(); }
+		value_compare value_comp() const { return value_compare(key_comp()); }
+
+	private:
+
+		template<class U>
+		void insert_range(U first, U last, ft::input_iterator_tag) {
+			while (first != last)
+				insert(end(), *first++);
+		}
+
+		/*
+		 * An empty container filled from a sorted, duplicate-free range gets the same
+		 * tree as from_sorted_unique would build. Checking costs one pass of n - 1
+		 * comparisons, which the per-element inserts would have paid many times over.
+		 */
+		template<class U>
+		void insert_range(U first, U last, ft::forward_iterator_tag) {
+			size_type n;
+			if (!_size && (n = this->sorted_length(first, last))) {
+				_tree->assign_sorted(first, n);
+				_size = n;
+				return;
+			}
+			this->insert_range(first, last, ft::input_iterator_tag());
+		}
+
+		// Length of [first, last) if it is strictly increasing, 0 otherwise.
+		template<class U>
+		size_type sorted_length(U first, U last) const {
+			if (first == last)
+				return 0;
+			value_compare comp = value_comp();
+			size_type n = 1;
+			for (U prev = first++; first != last; prev = first++, ++n)
+				if (!comp(*prev, *first))
+					return 0;
+			return n;
+		}
 	};
 
-	template<class Key, class Compare, class Alloc>
-	bool operator==(const ft::set<Key, Compare, Alloc> &lhs, const ft::set<Key, Compare, Alloc> &rhs) {
+	template<class Key, class Compare, class Alloc, class Options>
+	bool operator==(const ft::set<Key, Compare, Alloc, Options> &lhs, const ft::set<Key, Compare, Alloc, Options> &rhs) {
 		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
 	}
 
-	template<class Key, class Compare, class Alloc>
-	bool operator!=(const ft::set<Key, Compare, Alloc> &lhs, const ft::set<Key, Compare, Alloc> &rhs) {
+	template<class Key, class Compare, class Alloc, class Options>
+	bool operator!=(const ft::set<Key, Compare, Alloc, Options> &lhs, const ft::set<Key, Compare, Alloc, Options> &rhs) {
 		return (!(lhs == rhs));
 	}
 
-	template<class Key, class Compare, class Alloc>
-	bool operator<(const ft::set<Key, Compare, Alloc> &lhs, const ft::set<Key, Compare, Alloc> &rhs) {
+	template<class Key, class Compare, class Alloc, class Options>
+	bool operator<(const ft::set<Key, Compare, Alloc, Options> &lhs, const ft::set<Key, Compare, Alloc, Options> &rhs) {
 		return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 	}
 
-	template<class Key, class Compare, class Alloc>
-	bool operator<=(const ft::set<Key, Compare, Alloc> &lhs, const ft::set<Key, Compare, Alloc> &rhs) {
+	template<class Key, class Compare, class Alloc, class Options>
+	bool operator<=(const ft::set<Key, Compare, Alloc, Options> &lhs, const ft::set<Key, Compare, Alloc, Options> &rhs) {
 		return (!(rhs < lhs));
 	}
 
-	template<class Key, class Compare, class Alloc>
-	bool operator>(const ft::set<Key, Compare, Alloc> &lhs, const ft::set<Key, Compare, Alloc> &rhs) {
+	template<class Key, class Compare, class Alloc, class Options>
+	bool operator>(const ft::set<Key, Compare, Alloc, Options> &lhs, const ft::set<Key, Compare, Alloc, Options> &rhs) {
 		return (rhs < lhs);
 	}
 
-	template<class Key, class Compare, class Alloc>
-	bool operator>=(const ft::set<Key, Compare, Alloc> &lhs, const ft::set<Key, Compare, Alloc> &rhs) {
+	template<class Key, class Compare, class Alloc, class Options>
+	bool operator>=(const ft::set<Key, Compare, Alloc, Options> &lhs, const ft::set<Key, Compare, Alloc, Options> &rhs) {
 		return (!(lhs < rhs));
 	}
+
+	template<class Key, class Compare, class Alloc, class Options>
+	void swap(ft::set<Key, Compare, Alloc, Options> &x, ft::set<Key, Compare, Alloc, Options> &y) {
+		x.swap(y);
+	}
 	
 }
 
@@ -0,0 +1,159 @@
+#ifndef FT_CONTAINERS_SMALL_VECTOR_HPP
+#define FT_CONTAINERS_SMALL_VECTOR_HPP
+
+#include <vector.hpp>
+
+namespace ft {
+
+	/*
+	 * A vector that keeps its first N elements in an inline buffer and only goes to
+	 * the allocator once it grows past that. It is an ft::vector, with the same
+	 * iterators and API, so it can back an ft::stack.
+	 */
+	template<typename T, std::size_t N, class Allocator = std::allocator<T>, class Growth = ft::growth_double>
+	class small_vector : public vector<T, Allocator, Growth> {
+
+	public:
+		typedef vector<T, Allocator, Growth> base_type;
+		typedef typename base_type::value_type value_type;
+		typedef typename base_type::allocator_type allocator_type;
+		typedef typename base_type::pointer pointer;
+		typedef typename base_type::size_type size_type;
+		typedef typename base_type::iterator iterator;
+		typedef typename base_type::const_iterator const_iterator;
+
+	private:
+		char _storage[N * sizeof(T)] __attribute__((aligned(__alignof__(T))));
+
+	public:
+		explicit small_vector(const allocator_type &alloc = allocator_type()) : base_type(alloc) {
+			this->use_inline();
+		}
+
+		explicit small_vector(size_type n, const value_type &val = value_type(),
+							  const allocator_type &alloc = allocator_type()) : base_type(alloc) {
+			this->use_inline();
+			this->assign(n, val);
+		}
+
+		template<typename U>
+		small_vector(U first, U last, const allocator_type &alloc = allocator_type(),
+					 typename ft::enable_if<!ft::is_integral<U>::value, U>::type * = 0) : base_type(alloc) {
+			this->use_inline();
+			this->assign(first, last);
+		}
+
+		small_vector(const small_vector &other) : base_type(other.get_allocator()) {
+			this->use_inline();
+			this->assign(other.begin(), other.end());
+		}
+
+		small_vector(const base_type &other) : base_type(other.get_allocator()) {
+			this->use_inline();
+			this->assign(other.begin(), other.end());
+		}
+
+		small_vector &operator=(const small_vector &other) {
+			if (this != &other)
+				this->assign(other.begin(), other.end());
+			return *this;
+		}
+
+#if __cplusplus >= 201103L
+		small_vector(small_vector &&other) : base_type(other.get_allocator()) {
+			this->use_inline();
+			this->take(other);
+		}
+
+		small_vector(base_type &&other) : base_type(other.get_allocator()) {
+			this->use_inline();
+			this->take(other);
+		}
+
+		small_vector &operator=(small_vector &&other) {
+			if (this != &other)
+				this->take(other);
+			return *this;
+		}
+#endif
+
+		virtual ~small_vector() {
+			this->clear();
+			this->deallocate();
+			this->_container = NULL;
+			this->_capacity = 0;
+		}
+
+		bool is_inline() const {
+			return this->_container == inline_storage();
+		}
+
+		void swap(small_vector &other) {
+			if (!this->is_inline() && !other.is_inline()) {
+				base_type::swap(other);
+				return;
+			}
+			if (this->is_inline() && other.is_inline()) {
+				small_vector &longer = this->_size < other._size ? other : *this;
+				small_vector &shorter = this->_size < other._size ? *this : other;
+				for (size_type i = 0; i < shorter._size; ++i)
+					ft::swap(longer._container[i], shorter._container[i]);
+				shorter.relocate(shorter._container + shorter._size, longer._container + shorter._size,
+								 longer._size - shorter._size);
+				ft::swap(this->_size, other._size);
+				return;
+			}
+
+			small_vector &local = this->is_inline() ? *this : other;
+			small_vector &heap = this->is_inline() ? other : *this;
+			pointer buffer = heap._container;
+			size_type capacity = heap._capacity;
+
+			heap.use_inline();
+			heap.relocate(heap._container, local._container, local._size);
+			local._container = buffer;
+			local._capacity = capacity;
+			ft::swap(this->_size, other._size);
+		}
+
+	protected:
+		virtual pointer allocate_storage(size_type &n) {
+			if (n <= N && !this->is_inline()) {
+				n = N;
+				return inline_storage();
+			}
+			return base_type::allocate_storage(n);
+		}
+
+		virtual void deallocate_storage(pointer p, size_type n) {
+			if (p != inline_storage())
+				base_type::deallocate_storage(p, n);
+		}
+
+		virtual bool storage_is_transferable() const {
+			return this->_capacity != 0 && !this->is_inline();
+		}
+
+		virtual void reset_storage() {
+			this->use_inline();
+		}
+
+	private:
+		pointer inline_storage() const {
+			return reinterpret_cast<pointer>(const_cast<char *>(_storage));
+		}
+
+		void use_inline() {
+			this->_container = inline_storage();
+			this->_capacity = N;
+		}
+	};
+
+	template<class T, std::size_t N, class Alloc, class Growth>
+	void swap(small_vector<T, N, Alloc, Growth> &x, small_vector<T, N, Alloc, Growth> &y) {
+		x.swap(y);
+	}
+
+}
+
+#endif
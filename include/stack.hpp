@@ -5,11 +5,28 @@
 
 namespace ft {
 
-	template<class T, class Container = ft::vector<T> >
+	// Shrink policies are told about every pop and may give container memory back.
+	struct no_shrink {
+		template<class Container>
+		static void after_pop(Container &) {}
+	};
+
+	// Shrinks the container to fit once it drops below 1 / Divisor of its capacity.
+	template<std::size_t Divisor = 4>
+	struct shrink_below {
+		template<class Container>
+		static void after_pop(Container &container) {
+			if (container.size() < container.capacity() / Divisor)
+				container.shrink_to_fit();
+		}
+	};
+
+	template<class T, class Container = ft::vector<T>, class ShrinkPolicy = ft::no_shrink>
 	class stack {
 
 	public:
 		typedef Container									container_type;
+		typedef ShrinkPolicy								shrink_policy;
 		typedef typename container_type::value_type			value_type;
 		typedef typename container_type::size_type			size_type;
 		typedef typename container_type::reference			reference;
@@ -21,6 +38,8 @@ namespace ft {
 	public:
 		explicit stack(const Container& cont = Container()) : container(cont) {};
 
+		stack(const stack& other) : container(other.container) {};
+
 		~stack() {};
 
 		stack& operator=(const stack& other) {
@@ -28,6 +47,17 @@ namespace ft {
 			return *this;
 		}
 
+#if __cplusplus >= 201103L
+		explicit stack(Container&& cont) : container(std::move(cont)) {};
+
+		stack(stack&& other) : container(std::move(other.container)) {};
+
+		stack& operator=(stack&& other) {
+			container = std::move(other.container);
+			return *this;
+		}
+#endif
+
 		reference top() {
 			return container.back();
 		}
@@ -48,38 +78,54 @@ namespace ft {
 			container.push_back(value);
 		}
 
+#if __cplusplus >= 201103L
+		void push(value_type&& value) {
+			container.push_back(std::move(value));
+		}
+
+		template<class... Args>
+		void emplace(Args&&... args) {
+			container.emplace_back(std::forward<Args>(args)...);
+		}
+#endif
+
 		void pop() {
 			container.pop_back();
+			ShrinkPolicy::after_pop(container);
+		}
+
+		void shrink_to_fit() {
+			container.shrink_to_fit();
 		}
 	};
 
-	template< class T, class Container >
-	bool operator==(const stack<T,Container>& lhs, const stack<T,Container>& rhs) {
+	template< class T, class Container, class ShrinkPolicy >
+	bool operator==(const stack<T,Container,ShrinkPolicy>& lhs, const stack<T,Container,ShrinkPolicy>& rhs) {
 		return lhs.container == rhs.container;
 	}
 
-	template< class T, class Container >
-	bool operator!=(const stack<T,Container>& lhs, const stack<T,Container>& rhs) {
+	template< class T, class Container, class ShrinkPolicy >
+	bool operator!=(const stack<T,Container,ShrinkPolicy>& lhs, const stack<T,Container,ShrinkPolicy>& rhs) {
 		return lhs.container != rhs.container;
 	}
 
-	template< class T, class Container >
-	bool operator<(const stack<T,Container>& lhs, const stack<T,Container>& rhs) {
+	template< class T, class Container, class ShrinkPolicy >
+	bool operator<(const stack<T,Container,ShrinkPolicy>& lhs, const stack<T,Container,ShrinkPolicy>& rhs) {
 		return lhs.container < rhs.container;
 	}
 
-	template< class T, class Container >
-	bool operator<=(const stack<T,Container>& lhs, const stack<T,Container>& rhs) {
+	template< class T, class Container, class ShrinkPolicy >
+	bool operator<=(const stack<T,Container,ShrinkPolicy>& lhs, const stack<T,Container,ShrinkPolicy>& rhs) {
 		return lhs.container <= rhs.container;
 	}
 
-	template< class T, class Container >
-	bool operator>(const stack<T,Container>& lhs, const stack<T,Container>& rhs) {
+	template< class T, class Container, class ShrinkPolicy >
+	bool operator>(const stack<T,Container,ShrinkPolicy>& lhs, const stack<T,Container,ShrinkPolicy>& rhs) {
 		return lhs.container > rhs.container;
 	}
 
-	template< class T, class Container >
-	bool operator>=(const stack<T,Container>& lhs, const stack<T,Container>& rhs) {
+	template< class T, class Container, class ShrinkPolicy >
+	bool operator>=(const stack<T,Container,ShrinkPolicy>& lhs, const stack<T,Container,ShrinkPolicy>& rhs) {
 		return lhs.container >= rhs.container;
 	}
 
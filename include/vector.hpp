@@ -2,12 +2,11 @@
 #define FT_CONTAINERS_VECTOR_HPP
 
 #include <memory>
+#include <cstring>
 #include <ft_iterator.hpp>
 #include <ft_algorithm.hpp>
 #include <iostream>
 #include <unistd.h>
-#include <memory>
-#include <type_traits>
 
 namespace ft {
 
@@ -16,17 +15,17 @@ namespace ft {
 
 	public:
 		typedef T iterator_type;
-		typedef typename iterator_traits<iterator_type>::iterator_category iterator_category;
-		typedef typename iterator_traits<iterator_type>::value_type value_type;
-		typedef typename iterator_traits<iterator_type>::difference_type difference_type;
-		typedef typename iterator_traits<iterator_type>::pointer pointer;
-		typedef typename iterator_traits<iterator_type>::reference reference;
+		typedef typename iterator_traits<iterator_type *>::iterator_category iterator_category;
+		typedef typename iterator_traits<iterator_type *>::value_type value_type;
+		typedef typename iterator_traits<iterator_type *>::difference_type difference_type;
+		typedef typename iterator_traits<iterator_type *>::pointer pointer;
+		typedef typename iterator_traits<iterator_type *>::reference reference;
 
 	protected:
 		pointer ptr;
 
 	public:
-		vector_iterator() : ptr(nullptr) {}
+		vector_iterator() : ptr(NULL) {}
 
 		vector_iterator(pointer ptr) : ptr(ptr) {}
 
@@ -119,12 +118,58 @@ namespace ft {
 	template<typename U, typename X>
 	bool operator>=(const vector_iterator<U> &lhs, const vector_iterator<X> &rhs) { return lhs.base() >= rhs.base(); }
 
-	template<typename T, class Allocator = std::allocator<T> >
+	template<typename U, typename X>
+	bool equal(vector_iterator<U> lit, vector_iterator<U> lend, vector_iterator<X> rit, vector_iterator<X> rend) {
+		return ft::equal(lit.base(), lend.base(), rit.base(), rend.base());
+	}
+
+	template<typename U, typename X>
+	bool lexicographical_compare(vector_iterator<U> first1, vector_iterator<U> last1,
+								 vector_iterator<X> first2, vector_iterator<X> last2) {
+		return ft::lexicographical_compare(first1.base(), last1.base(), first2.base(), last2.base());
+	}
+
+	/*
+	 * Growth policies decide the capacity a vector moves to when it runs out of room.
+	 * next_capacity() receives the current capacity, the minimum capacity required
+	 * and the element size, and must return a value >= required.
+	 */
+	template<std::size_t Num, std::size_t Den>
+	struct growth_factor {
+		static std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t) {
+			std::size_t grown = capacity + capacity / Den * (Num - Den) + capacity % Den * (Num - Den) / Den;
+			if (grown < capacity || grown < required)
+				return required;
+			return grown;
+		}
+	};
+
+	typedef growth_factor<2, 1> growth_double;
+	typedef growth_factor<3, 2> growth_one_and_half;
+
+	// Doubles the buffer, then rounds its byte size up to a whole number of pages.
+	template<std::size_t PageSize = 4096>
+	struct growth_page_aligned {
+		static std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t element_size) {
+			std::size_t n = growth_double::next_capacity(capacity, required, element_size);
+			std::size_t bytes = n * element_size;
+			bytes = (bytes + PageSize - 1) / PageSize * PageSize;
+			if (bytes / element_size < n)
+				return n;
+			return bytes / element_size;
+		}
+	};
+
+	template<typename T, std::size_t N, class Allocator, class Growth>
+	class small_vector;
+
+	template<typename T, class Allocator = std::allocator<T>, class Growth = ft::growth_double>
 	class vector {
 
 	public:
 		typedef T value_type;
 		typedef Allocator allocator_type;
+		typedef Growth growth_policy;
 		typedef typename allocator_type::reference reference;
 		typedef typename allocator_type::const_reference const_reference;
 		typedef typename allocator_type::pointer pointer;
@@ -145,14 +190,14 @@ namespace ft {
 	public:
 		explicit vector(const allocator_type &alloc = allocator_type()) :
 				_allocator(alloc),
-				_container(nullptr),
+				_container(NULL),
 				_capacity(0),
 				_size(0) {}
 
 		explicit vector(size_type n, const value_type &val = value_type(),
 						const allocator_type &alloc = allocator_type()) :
 				_allocator(alloc),
-				_container(nullptr),
+				_container(NULL),
 				_capacity(0),
 				_size(0) {
 			this->assign(n, val);
@@ -162,51 +207,66 @@ namespace ft {
 		template<typename U>
 		vector(U first, U last, const allocator_type &alloc = allocator_type(),
 			   typename ft::enable_if<!ft::is_integral<U>::value, U>::type * = 0) : _allocator(alloc),
-																					_container(nullptr), _capacity(0),
+																					_container(NULL), _capacity(0),
 																					_size(0) {
 			this->template assign(first, last);
 		}
 
-		vector(const vector &other) : _allocator(other._allocator), _container(nullptr), _capacity(0), _size(0) {
+		vector(const vector &other) : _allocator(other._allocator), _container(NULL), _capacity(0), _size(0) {
 			this->template assign(other.begin(), other.end());
 		}
 
 		vector &operator=(const vector &other) {
-			this->template assign(other.begin(), other.end());
+			if (this != &other)
+				this->template assign(other.begin(), other.end());
 			return *this;
 		}
 
+#if __cplusplus >= 201103L
+		/*
+		 * noexcept so that standard containers relocate vectors by moving them: the
+		 * buffer changes hands and nothing is allocated or moved element-wise. A
+		 * small_vector source, whose elements may sit in its inline buffer, picks the
+		 * overloads below instead, which can allocate and so may throw.
+		 */
+		vector(vector &&other) noexcept : _allocator(other._allocator), _container(NULL), _capacity(0), _size(0) {
+			this->take(other);
+		}
+
+		vector &operator=(vector &&other) noexcept {
+			if (this != &other)
+				this->take(other);
+			return *this;
+		}
+
+		template<std::size_t N>
+		vector(small_vector<T, N, Allocator, Growth> &&other)
+				: _allocator(other.get_allocator()), _container(NULL), _capacity(0), _size(0) {
+			this->take(other);
+		}
+
+		template<std::size_t N>
+		vector &operator=(small_vector<T, N, Allocator, Growth> &&other) {
+			if (this != &other)
+				this->take(other);
+			return *this;
+		}
+#endif
+
 		virtual ~vector() {
 			this->clear();
 			this->deallocate();
 		}
 
 		void clear() {
-			for (size_type i = 0; i < _size; i++)
-				_allocator.destroy(&_container[i]);
+			this->destroy(_container, _container + _size);
 			_size = 0;
 		}
 
 		template<typename U>
 		void assign(U first, U last, typename ft::enable_if<!ft::is_integral<U>::value, U>::type * = 0) {
-
 			this->clear();
-
-			for (U tmp = first; tmp != last; tmp++)
-				_size++;
-
-			if (_size > _capacity) {
-				this->deallocate();
-				_capacity = _size;
-				_container = _allocator.allocate(_capacity);
-			}
-
-			size_type i = 0;
-			while (first != last) {
-				_allocator.construct(_container + i, *first);
-				first++;
-				i++;
-			}
+			this->assign_range(first, last, ft::iterator_category(first));
 		}
 
 		void assign(size_type n, const value_type &val) {
@@ -214,9 +274,11 @@ namespace ft {
 			this->clear();
 			_size = n;
 			if (_size > _capacity) {
+				size_type capacity = _size;
 				this->deallocate();
-				_capacity = _size;
-				_container = _allocator.allocate(_capacity);
+				_capacity = 0;
+				_container = this->allocate_storage(capacity);
+				_capacity = capacity;
 			}
 
 			size_type i = 0;
@@ -237,11 +299,10 @@ namespace ft {
 				throw std::length_error("The vector _capacity cannot be greater than _allocator max _size.");
 			if (n <= _capacity) return;
 
-			pointer tmp = _allocator.allocate(n);
-			for (size_type i = 0; i < _size; ++i) {
-				_allocator.construct(tmp + i, _container[i]);
-				_allocator.destroy(&_container[i]);
-			}
+			if (this->try_reallocate(n)) return;
+
+			pointer tmp = this->allocate_storage(n);
+			this->relocate(tmp, _container, _size);
 			this->deallocate();
 			_capacity = n;
 			_container = tmp;
@@ -285,12 +346,11 @@ namespace ft {
 
 		void resize(size_type n, value_type val = value_type()) {
 			if (n <= _size) {
-				for (size_type i = n; i < _size; ++i)
-					_allocator.destroy(&_container[i]);
+				this->destroy(_container + n, _container + _size);
 				_size = n;
 			}
 
-			this->reserve(n);
+			this->grow(n);
 
 			if (n > _size) {
 				for (size_type i = _size; i < n; ++i)
@@ -299,6 +359,51 @@ namespace ft {
 			}
 		}
 
+		/*
+		 * Like resize(n), except that new elements are default-initialized: trivially
+		 * constructible types are left uninitialized instead of being copied from a value.
+		 */
+		void resize_default_init(size_type n) {
+			if (n <= _size) {
+				this->destroy(_container + n, _container + _size);
+				_size = n;
+				return;
+			}
+
+			this->grow(n);
+			this->default_init(n, ft::is_trivially_default_constructible<value_type>());
+		}
+
+		// Appends n default-initialized elements and returns a pointer to the first of them.
+		pointer reserve_and_append_uninitialized(size_type n) {
+			size_type i = _size;
+			this->resize_default_init(_size + n);
+			return _container + i;
+		}
+
+		// Releases unused capacity. Buffers not owned by the allocator are kept.
+		void shrink_to_fit() {
+			if (_size == _capacity || !this->storage_is_transferable()) return;
+
+			if (!_size) {
+				this->deallocate();
+				this->reset_storage();
+				return;
+			}
+			if (this->try_reallocate(_size)) return;
+
+			size_type n = _size;
+			pointer tmp = this->allocate_storage(n);
+			if (n >= _capacity) {
+				this->deallocate_storage(tmp, n);
+				return;
+			}
+			this->relocate(tmp, _container, _size);
+			this->deallocate();
+			_capacity = n;
+			_container = tmp;
+		}
+
 		size_type capacity() const {
 			return _capacity;
 		}
@@ -346,13 +451,54 @@ namespace ft {
 		}
 
 		void push_back(const value_type &val) {
-			this->reserve(_size + 1);
+			if (_size == _capacity) {
+				this->insert(end(), 1, val);
+				return;
+			}
 			_allocator.construct(_container + _size, val);
 			_size += 1;
 		}
 
+#if __cplusplus >= 201103L
+		void push_back(value_type &&val) {
+			this->emplace_back(std::move(val));
+		}
+
+		template<class... Args>
+		void emplace_back(Args &&... args) {
+			if (_size == _capacity) {
+				this->emplace(end(), std::forward<Args>(args)...);
+				return;
+			}
+			_allocator.construct(_container + _size, std::forward<Args>(args)...);
+			_size += 1;
+		}
+
+		// The value is built before the gap is opened, since args may refer to elements.
+		template<class... Args>
+		iterator emplace(iterator position, Args &&... args) {
+			value_type tmp(std::forward<Args>(args)...);
+
+			size_type i = position - begin();
+			pointer gap = this->open_gap(i, 1);
+			try {
+				_allocator.construct(gap, std::move(tmp));
+			} catch (...) {
+				this->close_gap(i, 1, 0);
+				throw;
+			}
+			_size += 1;
+			return iterator(gap);
+		}
+
+		iterator insert(iterator position, value_type &&val) {
+			return this->emplace(position, std::move(val));
+		}
+#endif
+
 		void pop_back() {
-			this->resize(_size - 1);
+			_size -= 1;
+			this->destroy(_container + _size, _container + _size + 1);
 		}
 
 		iterator insert(iterator position, const value_type &val) {
@@ -362,50 +508,40 @@ namespace ft {
 		}
 
 		void insert(iterator position, size_type n, const value_type &val) {
-			vector<T> tmp(*this);
+			if (!n) return;
 
-			size_type i = position - begin();
-
-			this->reserve(_size + n);
-
-			for (size_type j = i; j < i + n; ++j)
-				_allocator.construct(_container + j, val);
-			for (size_type j = i + n; j < _size + n; ++j)
-				_allocator.construct(_container + j, tmp[j - n]);
+			if (&val >= _container && &val < _container + _size) {
+				value_type copy(val);
+				this->insert(position, n, copy);
+				return;
+			}
 
+			size_type i = position - begin();
+			pointer gap = this->open_gap(i, n);
+
+			size_type j = 0;
+			try {
+				for (; j < n; ++j)
+					_allocator.construct(gap + j, val);
+			} catch (...) {
+				this->close_gap(i, n, j);
+				throw;
+			}
 			_size += n;
 		}
 
 		template<class U>
 		void
 		insert(iterator position, U first, U last, typename ft::enable_if<!ft::is_integral<U>::value, U>::type * = 0) {
-			vector tmp(*this);
-
-			size_type n = 0;
-			for (U it = first; it != last; it++)
-				n++;
-
-			size_type i = position - begin();
-
-			this->reserve(_size + n);
-
-			_size += n;
-
-			for (size_type j = i; j < i + n; ++j)
-				_allocator.construct(_container + j, *first++);
-
-			for (size_type j = i + n; j < _size; ++j)
-				_allocator.construct(_container + j, tmp[j - n]);
+			this->insert_range(position, first, last, ft::iterator_category(first));
 		}
 
 		iterator erase(iterator position) {
 
 			size_type i = position - begin();
 
-			for (size_type j = i; j < _size; ++j) {
-				_allocator.destroy(&_container[j]);
-				if (j + 1 < _size) _allocator.construct(_container + j, _container[j + 1]);
-			}
+			_allocator.destroy(_container + i);
+			this->relocate(_container + i, _container + i + 1, _size - i - 1);
 
 			_size -= 1;
 			return position;
@@ -413,25 +549,34 @@ namespace ft {
 
 		iterator erase(iterator first, iterator last) {
 
-			vector tmp(*this);
-
 			size_type i = first - begin();
 			size_type n = last - first;
 
-			for (size_type j = i; j < _size; ++j)
-				_allocator.destroy(&_container[j]);
-
-			for (size_type j = i + n; j < _size; ++j)
-				_allocator.construct(_container + (j - n), tmp[j]); // 1 2 3 4 5 6 7 8 9 10 11 12
-			// 4 5 6 7 8 9 10 11 12
+			this->destroy(_container + i, _container + i + n);
+			this->relocate(_container + i, _container + i + n, _size - i - n);
 
 			_size -= n;
 			return first;
 		}
 
+		/*
+		 * Exchanges buffers when both sides own theirs outright. A buffer that cannot be
+		 * handed over, like a small_vector's inline one, is swapped element by element.
+		 */
 		void swap(vector &other) {
-			ft::swap(_container, other._container);
-			ft::swap(_capacity, other._capacity);
+			if (this->storage_is_exchangeable() && other.storage_is_exchangeable()) {
+				ft::swap(_container, other._container);
+				ft::swap(_capacity, other._capacity);
+				ft::swap(_size, other._size);
+				return;
+			}
+			vector &longer = _size < other._size ? other : *this;
+			vector &shorter = _size < other._size ? *this : other;
+			shorter.reserve(longer._size);
+			for (size_type i = 0; i < shorter._size; ++i)
+				ft::swap(longer._container[i], shorter._container[i]);
+			shorter.relocate(shorter._container + shorter._size, longer._container + shorter._size,
+							 longer._size - shorter._size);
 			ft::swap(_size, other._size);
 		}
 
@@ -439,52 +584,266 @@ namespace ft {
 			return _allocator;
 		}
 
-	private:
+	protected:
+
+		/*
+		 * Every buffer the vector owns is obtained and released through these two hooks,
+		 * so that derived containers can serve some of them from elsewhere. n may be
+		 * raised to the capacity the returned buffer really provides.
+		 */
+		virtual pointer allocate_storage(size_type &n) {
+			return _allocator.allocate(n);
+		}
+
+		virtual void deallocate_storage(pointer p, size_type n) {
+			_allocator.deallocate(p, n);
+		}
+
+		// Whether the current buffer may be handed over to another vector on a move.
+		virtual bool storage_is_transferable() const {
+			return _capacity != 0;
+		}
+
+		// No buffer at all can be exchanged as freely as one the vector owns.
+		bool storage_is_exchangeable() const {
+			return !_capacity || this->storage_is_transferable();
+		}
+
+		// Leaves the vector without a buffer once its own was handed over or released.
+		virtual void reset_storage() {
+			_container = NULL;
+			_capacity = 0;
+		}
+
+#if __cplusplus >= 201103L
+		void take(vector &other) {
+			this->clear();
+			if (other.storage_is_transferable()) {
+				this->deallocate();
+				_container = other._container;
+				_capacity = other._capacity;
+				_size = other._size;
+				other.reset_storage();
+				other._size = 0;
+				return;
+			}
+			this->reserve(other._size);
+			for (; _size < other._size; ++_size)
+				_allocator.construct(_container + _size, std::move(other._container[_size]));
+			other.clear();
+		}
+#endif
 
 		void deallocate() {
-			if (_capacity) _allocator.deallocate(_container, _capacity);
+			if (_capacity) this->deallocate_storage(_container, _capacity);
 		}
 
-	};
+		void destroy(pointer first, pointer last) {
+			this->destroy(first, last, ft::is_trivially_destructible<value_type>());
+		}
+
+		void destroy(pointer, pointer, ft::true_type) {}
+
+		void destroy(pointer first, pointer last, ft::false_type) {
+			for (; first != last; ++first)
+				_allocator.destroy(first);
+		}
+
+		/*
+		 * Moves n elements from src to dst, leaving the source slots uninitialized.
+		 * The two ranges may overlap.
+		 */
+		void relocate(pointer dst, pointer src, size_type n) {
+			if (n && dst != src)
+				this->relocate(dst, src, n, ft::is_trivially_relocatable<value_type>());
+		}
+
+		void relocate(pointer dst, pointer src, size_type n, ft::true_type) {
+			std::memmove(static_cast<void *>(dst), static_cast<const void *>(src), n * sizeof(value_type));
+		}
+
+		void relocate(pointer dst, pointer src, size_type n, ft::false_type) {
+			if (dst < src) {
+				for (size_type i = 0; i < n; ++i) {
+					_allocator.construct(dst + i, ft::move(src[i]));
+					_allocator.destroy(src + i);
+				}
+			} else {
+				for (size_type i = n; i > 0; --i) {
+					_allocator.construct(dst + i - 1, ft::move(src[i - 1]));
+					_allocator.destroy(src + i - 1);
+				}
+			}
+		}
+
+	private:
+
+		// Single pass: input ranges cannot be walked twice, other ranges are not worth it.
+		template<class U>
+		void assign_range(U first, U last, ft::input_iterator_tag) {
+			for (; first != last; ++first)
+				this->push_back(*first);
+		}
+
+		template<class U>
+		void assign_range(U first, U last, ft::random_access_iterator_tag) {
+			size_type n = ft::distance(first, last);
+
+			if (n > _capacity) {
+				if (n > max_size())
+					throw std::length_error("The vector _capacity cannot be greater than _allocator max _size.");
+				size_type capacity = n;
+				this->deallocate();
+				_capacity = 0;
+				_container = this->allocate_storage(capacity);
+				_capacity = capacity;
+			}
+
+			for (; first != last; ++first) {
+				_allocator.construct(_container + _size, *first);
+				_size++;
+			}
+		}
+
+		template<class U>
+		void insert_range(iterator position, U first, U last, ft::input_iterator_tag) {
+			if (position == end()) {
+				for (; first != last; ++first)
+					this->push_back(*first);
+				return;
+			}
+			vector tmp(_allocator);
+			tmp.assign_range(first, last, ft::input_iterator_tag());
+			this->insert_range(position, tmp.begin(), tmp.end(), ft::random_access_iterator_tag());
+		}
+
+		template<class U>
+		void insert_range(iterator position, U first, U last, ft::random_access_iterator_tag) {
+			size_type n = ft::distance(first, last);
+			if (!n) return;
+
+			size_type i = position - begin();
+			pointer gap = this->open_gap(i, n);
+
+			size_type j = 0;
+			try {
+				for (; j < n; ++j)
+					_allocator.construct(gap + j, *first++);
+			} catch (...) {
+				this->close_gap(i, n, j);
+				throw;
+			}
+			_size += n;
+		}
 
-	template<class T, class Alloc>
-	bool operator==(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs) {
-		if (lhs.size() != rhs.size()) return false;
+		void default_init(size_type n, ft::true_type) {
+			_size = n;
+		}
+
+		void default_init(size_type n, ft::false_type) {
+			for (; _size < n; ++_size)
+				_allocator.construct(_container + _size, value_type());
+		}
 
-		for (size_t i = 0; i < lhs.size(); i++)
-			if (lhs[i] != rhs[i])
+		size_type recommend(size_type required) const {
+			size_type n = Growth::next_capacity(_capacity, required, sizeof(value_type));
+			if (n > max_size())
+				n = required > max_size() ? required : max_size();
+			return n;
+		}
+
+		void grow(size_type required) {
+			if (required <= _capacity) return;
+			this->reserve(this->recommend(required));
+		}
+
+		/*
+		 * Makes room for n uninitialized slots at index i, shifting the tail inside the
+		 * current buffer or relocating both halves into a single new one.
+		 */
+		pointer open_gap(size_type i, size_type n) {
+			if (_size + n > _capacity) {
+				size_type capacity = this->recommend(_size + n);
+				if (capacity > max_size())
+					throw std::length_error("The vector _capacity cannot be greater than _allocator max _size.");
+				if (!this->try_reallocate(capacity))
+					return this->open_gap_in(capacity, i, n);
+			}
+			this->relocate(_container + i + n, _container + i, _size - i);
+			return _container + i;
+		}
+
+		// Builds a new buffer of the given capacity with the gap already in place.
+		pointer open_gap_in(size_type capacity, size_type i, size_type n) {
+			pointer tmp = this->allocate_storage(capacity);
+			this->relocate(tmp, _container, i);
+			this->relocate(tmp + i + n, _container + i, _size - i);
+			this->deallocate();
+			_capacity = capacity;
+			_container = tmp;
+			return _container + i;
+		}
+
+		/*
+		 * Grows or shrinks the buffer to n elements through the allocator's reallocate()
+		 * when both the allocator and the element type allow it (see mmap_allocator).
+		 */
+		bool try_reallocate(size_type n) {
+			return this->try_reallocate(n, ft::integral_constant<bool,
+					ft::is_trivially_relocatable<value_type>::value && ft::allocator_can_reallocate<allocator_type>::value>());
+		}
+
+		bool try_reallocate(size_type, ft::false_type) {
+			return false;
+		}
+
+		bool try_reallocate(size_type n, ft::true_type) {
+			if (!this->storage_is_transferable())
 				return false;
+			_container = _allocator.reallocate(_container, _capacity, n);
+			_capacity = n;
+			return true;
+		}
+
+		// Undoes open_gap after the first `constructed` slots of the gap were built.
+		void close_gap(size_type i, size_type n, size_type constructed) {
+			this->destroy(_container + i, _container + i + constructed);
+			this->relocate(_container + i, _container + i + n, _size - i);
+		}
+	};
 
-		return true;
+	template<class T, class Alloc, class Growth>
+	bool operator==(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs) {
+		return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 	}
 
-	template<class T, class Alloc>
-	bool operator!=(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs) {
+	template<class T, class Alloc, class Growth>
+	bool operator!=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs) {
 		return !(lhs == rhs);
 	}
 
-	template<class T, class Alloc>
-	bool operator<(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs) {
+	template<class T, class Alloc, class Growth>
+	bool operator<(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs) {
 		return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 	}
 
-	template<class T, class Alloc>
-	bool operator<=(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs) {
+	template<class T, class Alloc, class Growth>
+	bool operator<=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs) {
 		return !(rhs < lhs);
 	}
 
-	template<class T, class Alloc>
-	bool operator>(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs) {
+	template<class T, class Alloc, class Growth>
+	bool operator>(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs) {
 		return rhs < lhs;
 	}
 
-	template<class T, class Alloc>
-	bool operator>=(const vector<T, Alloc> &lhs, const vector<T, Alloc> &rhs) {
+	template<class T, class Alloc, class Growth>
+	bool operator>=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs) {
 		return !(lhs < rhs);
 	}
 
-	template<class T, class Alloc>
-	void swap(vector<T, Alloc> &x, vector<T, Alloc> &y) {
+	template<class T, class Alloc, class Growth>
+	void swap(vector<T, Alloc, Growth> &x, vector<T, Alloc, Growth> &y) {
 		x.swap(y);
 	}
 